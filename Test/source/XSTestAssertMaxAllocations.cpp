@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        XSTestAssertMaxAllocations.cpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#include <XSTest/XSTest.hpp>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+XSTest( Success, XSTestAssertMaxAllocations )
+{
+    int              i( 0 );
+    std::vector< int > v;
+    
+    /* Allocations are only tracked when XSTEST_TRACK_ALLOCATIONS is defined with the main function */
+    if( XS::Test::Allocations::IsTracking() == false )
+    {
+        return;
+    }
+    
+    v.reserve( 10 );
+    
+    XSTestAssertMaxAllocations( i++, 0 );
+    XSTestAssertMaxAllocations( v.push_back( i ), 0 );
+    XSTestAssertMaxAllocations( std::unique_ptr< int >( new int( i ) ), 1 );
+}
+
+XSTest( Success, XSTestAssertMaxAllocationsThrow )
+{
+    XS::Test::Allocations::Counters begin;
+    
+    if( XS::Test::Allocations::IsTracking() == false )
+    {
+        return;
+    }
+    
+    begin = XS::Test::Allocations::Begin();
+    
+    std::unique_ptr< char[] >( new char[ 4096 ] );
+    
+    /* The measure still ends when the expression throws, so the peak of the enclosing measure is kept */
+    XSTestAssertThrow( XSTestAssertMaxAllocations( throw std::runtime_error( "error" ), 0 ), std::runtime_error );
+    XSTestAssertGreaterOrEqual( XS::Test::Allocations::End( begin ).GetPeak(), static_cast< uint64_t >( 4096 ) );
+}
+
+XSTest( Failure, XSTestAssertMaxAllocations )
+{
+    XSTestAssertMaxAllocations( std::vector< int >( 10 ), 0 );
+}
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        XSTestBenchmark.cpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#include <XSTest/XSTest.hpp>
+#include <string>
+#include <vector>
+#include <chrono>
+
+class XSTestBenchmarkFixture: public XS::Test::Case
+{
+    protected:
+        
+        void SetUp() override
+        {
+            this->_values = std::vector< int >( 1000, 42 );
+        }
+        
+        std::vector< int > _values;
+};
+
+XSTestBenchmark( Success, XSTestBenchmark )
+{
+    std::string s( "hello, world" );
+    
+    XS::Test::Benchmark::DoNotOptimize( s );
+}
+
+XSTestBenchmarkFixture( XSTestBenchmarkFixture, Sum )
+{
+    int sum( 0 );
+    
+    for( int i: this->_values )
+    {
+        sum += i;
+    }
+    
+    XS::Test::Benchmark::DoNotOptimize( sum );
+}
+
+XSTest( Success, XSTestBenchmarkRun )
+{
+    std::string         s( "hello, world" );
+    XS::Test::Benchmark benchmark( XS::Test::Benchmark::Run( [ & ] { XS::Test::Benchmark::DoNotOptimize( s ); }, std::chrono::milliseconds( 1 ) ) );
+    
+    XSTestAssertGreater( benchmark.GetIterations(), static_cast< size_t >( 0 ) );
+    XSTestAssertEqual( benchmark.GetStatistics().GetCount(), static_cast< size_t >( 20 ) );
+    XSTestAssertEqual( benchmark.GetStatistics().GetSamples().size(), static_cast< size_t >( 20 ) );
+    XSTestAssertLessOrEqual( benchmark.GetStatistics().GetMin(), benchmark.GetStatistics().GetMedian() );
+    XSTestAssertLessOrEqual( benchmark.GetStatistics().GetMedian(), benchmark.GetStatistics().GetMax() );
+}
@@ -83,3 +83,25 @@ XSTestFixture( XSTestFixture, Test5 )
     
     XSTestAssertEqual( this->_x, 42 );
 }
+
+class XSTestFailingFixture: public XS::Test::Case
+{
+    protected:
+        
+        void SetUp() override
+        {
+            XSTestAssertTrue( false );
+        }
+        
+        void TearDown() override
+        {
+            XSTestExpectEqual( this->_x, 0 );
+        }
+        
+        int _x = 42;
+};
+
+XSTestFixture( XSTestFailingFixture, Failure )
+{
+    this->_x = 0;
+}
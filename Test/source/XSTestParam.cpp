@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        XSTestParam.cpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#include <XSTest/XSTest.hpp>
+#include <vector>
+#include <string>
+
+static std::vector< int > XSTestParamSquares()
+{
+    std::vector< int > squares;
+    
+    for( int i = 0; i < 100; i++ )
+    {
+        squares.push_back( i * i );
+    }
+    
+    return squares;
+}
+
+XSTestParam( Success, XSTestParam, int )
+{
+    XSTestAssertGreater( this->GetParam(), 0 );
+}
+
+XSTestInstantiate( Success, XSTestParam, 1, 2, 3, 42 );
+
+XSTestParam( Success, XSTestParamTable, int )
+{
+    int root( static_cast< int >( this->Info().GetParameterIndex() ) );
+    
+    XSTestAssertEqual( this->GetParam(), root * root );
+}
+
+XSTestInstantiateTable( Success, XSTestParamTable, XSTestParamSquares() );
+
+XSTestParam( Failure, XSTestParam, std::string )
+{
+    XSTestAssertStringEqual( this->GetParam().c_str(), "hello, world" );
+}
+
+XSTestInstantiate( Failure, XSTestParam, "hello, universe" );
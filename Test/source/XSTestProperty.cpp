@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        XSTestProperty.cpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#include <XSTest/XSTest.hpp>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+using namespace XS::Test::Property;
+
+XSTest( Success, XSTestAssertProperty )
+{
+    XSTestAssertProperty( ForAll( Integer< int >( -1000, 1000 ), Integer< int >( -1000, 1000 ) ), []( int a, int b ) { return a + b == b + a; } );
+    XSTestAssertProperty( ForAll( Integer< uint8_t >() ), []( uint8_t v ) { return v <= 255; } );
+    XSTestAssertProperty( ForAll( Real< double >( -1.0, 1.0 ) ), []( double v ) { XSTestAssertLessOrEqual( v * v, 1.0 ); } );
+    XSTestAssertProperty( ForAll( String( 16 ) ), []( const std::string & s ) { return s.length() <= 16; } );
+    XSTestAssertProperty
+    (
+        ForAll( Vector< Integer< int > >( Integer< int >(), 32 ) ),
+        []( std::vector< int > v )
+        {
+            std::sort( v.begin(), v.end() );
+            
+            return std::is_sorted( v.begin(), v.end() );
+        }
+    );
+}
+
+XSTest( Failure, XSTestAssertProperty )
+{
+    XSTestAssertProperty( ForAll( Integer< int >( 0, 1000 ) ), []( int v ) { return v < 100; } );
+}
+
+XSTest( Success, XSTestExpectProperty )
+{
+    XSTestExpectProperty( ForAll( Integer< long >() ), []( long v ) { return v == v; } );
+}
+
+XSTest( Failure, XSTestExpectProperty )
+{
+    XSTestExpectProperty( ForAll( String() ), []( const std::string & s ) { XSTestAssertEqual( s.find( 'x' ), std::string::npos ); } );
+    XSTestExpectProperty( ForAll( Vector< Integer< int > >() ), []( const std::vector< int > & v ) { return v.size() < 3; } );
+}
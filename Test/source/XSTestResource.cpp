@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        XSTestResource.cpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#include <XSTest/XSTest.hpp>
+#include <vector>
+#include <memory>
+#include <atomic>
+
+static std::atomic< int > XSTestResourceCreated( 0 );
+
+XSTestResource( XSTestCorpus, std::vector< int > )
+{
+    XSTestResourceCreated++;
+    
+    return std::make_shared< std::vector< int > >( 1000, 42 );
+}
+
+XSTest( Success, XSTestResource )
+{
+    std::shared_ptr< std::vector< int > > corpus1( XSTestGetResource( XSTestCorpus ) );
+    std::shared_ptr< std::vector< int > > corpus2( XSTestGetResource( XSTestCorpus ) );
+    
+    XSTestAssertTrue( corpus1 == corpus2 );
+    XSTestAssertEqual( corpus1->size(), static_cast< size_t >( 1000 ) );
+    XSTestAssertEqual( XSTestResourceCreated.load(), 1 );
+}
+
+XSTest( XSTestResource, Shared )
+{
+    XSTestAssertEqual( XSTestGetResource( XSTestCorpus )->back(), 42 );
+    XSTestAssertEqual( XSTestResourceCreated.load(), 1 );
+}
+
+static std::atomic< int > XSTestResourceFailures( 0 );
+
+XSTestResource( XSTestMissing, std::vector< int > )
+{
+    XSTestResourceFailures++;
+    
+    return nullptr;
+}
+
+XSTest( Success, XSTestResourceFailedCreation )
+{
+    XSTestAssertTrue( XSTestGetResource( XSTestMissing ) == nullptr );
+    XSTestAssertTrue( XSTestGetResource( XSTestMissing ) == nullptr );
+    XSTestAssertEqual( XSTestResourceFailures.load(), 1 );
+}
+
+XSTestResource( XSTestIndex, std::vector< int > )
+{
+    return std::make_shared< std::vector< int > >( 1000, 42 );
+}
+
+XSTestUseResource( XSTestResourceUsers, XSTestIndex );
+
+XSTest( Success, XSTestResourceLastUser )
+{
+    std::weak_ptr< std::vector< int > > index( XSTestGetResource( XSTestIndex ) );
+    
+    XS::Test::Environment::AddUsers( "XSTestResourceUsers", 2 );
+    XS::Test::Environment::RemoveUser( "XSTestResourceUsers" );
+    XSTestAssertFalse( index.expired() );
+    XS::Test::Environment::RemoveUser( "XSTestResourceUsers" );
+    XSTestAssertTrue( index.expired() );
+    XSTestAssertFalse( XSTestGetResource( XSTestIndex ) == nullptr );
+}
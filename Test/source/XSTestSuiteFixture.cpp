@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        XSTestSuiteFixture.cpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#include <XSTest/XSTest.hpp>
+#include <vector>
+#include <memory>
+
+class XSTestSuiteFixture: public XS::Test::Case
+{
+    public:
+        
+        static void SetUpTestSuite()
+        {
+            _setUps++;
+            _data.reset( new std::vector< int >( 1000, 42 ) );
+        }
+        
+        static void TearDownTestSuite()
+        {
+            _data.reset();
+        }
+        
+    protected:
+        
+        static int                                  _setUps;
+        static std::unique_ptr< std::vector< int > > _data;
+};
+
+int                                   XSTestSuiteFixture::_setUps = 0;
+std::unique_ptr< std::vector< int > > XSTestSuiteFixture::_data;
+
+XSTestFixture( XSTestSuiteFixture, Test1 )
+{
+    XSTestAssertEqual( _setUps, 1 );
+    XSTestAssertTrue( _data != nullptr );
+    XSTestAssertEqual( _data->size(), static_cast< size_t >( 1000 ) );
+}
+
+XSTestFixture( XSTestSuiteFixture, Test2 )
+{
+    XSTestAssertEqual( _setUps, 1 );
+    XSTestAssertTrue( _data != nullptr );
+    XSTestAssertEqual( _data->back(), 42 );
+}
+
+class XSTestSharedSuiteFixture: public XS::Test::Case
+{
+    public:
+        
+        static void SetUpTestSuite()
+        {
+            _setUps++;
+        }
+        
+        static int _setUps;
+};
+
+int XSTestSharedSuiteFixture::_setUps = 0;
+
+XSTest( Success, XSTestSuiteFixtureSharedHooks )
+{
+    XS::Test::Registration r1( "XSTestSharedSuite1", "Test", nullptr, __FILE__, __LINE__, &XSTestSharedSuiteFixture::SetUpTestSuite, &XSTestSharedSuiteFixture::TearDownTestSuite );
+    XS::Test::Registration r2( "XSTestSharedSuite2", "Test", nullptr, __FILE__, __LINE__, &XSTestSharedSuiteFixture::SetUpTestSuite, &XSTestSharedSuiteFixture::TearDownTestSuite );
+    int                    setUps( XSTestSharedSuiteFixture::_setUps );
+    
+    /* Suites inheriting the same hooks are still set up separately */
+    XSTestAssertFalse( XS::Test::SuiteFixtures::SetUp( r1 ).HasValue() );
+    XSTestAssertFalse( XS::Test::SuiteFixtures::SetUp( r1 ).HasValue() );
+    XSTestAssertFalse( XS::Test::SuiteFixtures::SetUp( r2 ).HasValue() );
+    XSTestAssertEqual( XSTestSharedSuiteFixture::_setUps, setUps + 2 );
+    XSTestAssertFalse( XS::Test::SuiteFixtures::TearDown( r1 ).HasValue() );
+    XSTestAssertFalse( XS::Test::SuiteFixtures::TearDown( r2 ).HasValue() );
+}
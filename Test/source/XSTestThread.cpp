@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        XSTestThread.cpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#include <XSTest/XSTest.hpp>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <cstring>
+
+XSTest( Success, XSTestThread )
+{
+    std::atomic< int >               count( 0 );
+    std::vector< XS::Test::Thread > threads;
+    
+    for( int i = 0; i < 4; i++ )
+    {
+        threads.push_back( XS::Test::Thread( [ & ] { XSTestAssertTrue( count++ >= 0 ); } ) );
+    }
+    
+    for( auto & thread: threads )
+    {
+        thread.Join();
+    }
+    
+    XSTestAssertEqual( count.load(), 4 );
+}
+
+XSTest( Success, XSTestThreadJobs )
+{
+    std::vector< XS::Test::Collector > collectors( 4 );
+    XS::Test::ThreadPool               pool( collectors.size() );
+    std::atomic< int >                 after( 0 );
+    
+    /* Each task stands for a test case running with --jobs, starting a thread that fails */
+    for( size_t i = 0; i < collectors.size(); i++ )
+    {
+        XS::Test::Collector * collector( &( collectors[ i ] ) );
+        
+        pool.Submit
+        (
+            [ collector, i, &after ]
+            {
+                XS::Test::Collector::Scope scope( *( collector ) );
+                XS::Test::Thread           thread
+                (
+                    [ i, &after ]
+                    {
+                        XSTestExpectEqual( i, i + 1 );
+                        XSTestAssertTrue( false );
+                        
+                        after++;
+                    }
+                );
+            }
+        );
+    }
+    
+    pool.Wait();
+    
+    XSTestAssertEqual( after.load(), 0 );
+    
+    for( size_t i = 0; i < collectors.size(); i++ )
+    {
+        XSTestAssertEqual( collectors[ i ].GetCount(), static_cast< size_t >( 2 ) );
+        XSTestAssertStringEqual( collectors[ i ].GetFailures().front().GetEvaluated().c_str(), ( std::to_string( i ) + " == " + std::to_string( i + 1 ) ).c_str() );
+    }
+}
+
+XSTest( Success, XSTestThreadLifetime )
+{
+    std::unique_ptr< XS::Test::Thread > thread;
+    XS::Test::Collector                 failures;
+    
+    {
+        XS::Test::Collector        collector;
+        XS::Test::Collector::Scope scope( collector );
+        
+        failures = collector;
+        thread   = std::unique_ptr< XS::Test::Thread >( new XS::Test::Thread( [] { XSTestExpectTrue( false ); } ) );
+    }
+    
+    /* The thread keeps the failures alive after the collector that started it is gone */
+    thread.reset();
+    
+    XSTestAssertEqual( failures.GetCount(), static_cast< size_t >( 1 ) );
+}
+
+XSTest( Success, XSTestThreadMoveOnly )
+{
+    class Task
+    {
+        public:
+            
+            explicit Task( std::unique_ptr< int > value ):
+                _value( std::move( value ) )
+            {}
+            
+            void operator ()()
+            {
+                XSTestAssertEqual( *( this->_value ), 42 );
+            }
+            
+        private:
+            
+            std::unique_ptr< int > _value;
+    };
+    
+    XS::Test::Collector collector;
+    
+    {
+        XS::Test::Collector::Scope scope( collector );
+        XS::Test::Thread           thread( Task( std::unique_ptr< int >( new int( 42 ) ) ) );
+    }
+    
+    XSTestAssertEqual( collector.GetCount(), static_cast< size_t >( 0 ) );
+}
+
+XSTest( Success, XSTestThreadLocation )
+{
+    XS::Test::Collector collector;
+    size_t              line( 0 );
+    
+    {
+        XS::Test::Collector::Scope scope( collector );
+        
+        line = __LINE__ + 1;
+        XS::Test::Thread thread = XSTestThread( [] { throw std::runtime_error( "error" ); } );
+    }
+    
+    XSTestAssertEqual( collector.GetCount(), static_cast< size_t >( 1 ) );
+    XSTestAssertEqual( collector.GetFailures().front().GetLine(), line );
+    XSTestAssertTrue( std::strstr( __FILE__, collector.GetFailures().front().GetFile().c_str() ) != nullptr );
+}
+
+XSTest( Failure, XSTestThread )
+{
+    XS::Test::Thread t1( [] { XSTestAssertTrue( false ); } );
+    XS::Test::Thread t2( [] { XSTestExpectEqual( 42, 43 ); } );
+    
+    t1.Join();
+    t2.Join();
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        XSTestTyped.cpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#include <XSTest/XSTest.hpp>
+#include <vector>
+#include <deque>
+#include <list>
+#include <string>
+#include <cstdio>
+
+template< typename _T_ >
+class XSTestTypedFixture: public XS::Test::Case
+{
+    protected:
+        
+        void SetUp() override
+        {
+            this->_container.push_back( 42 );
+        }
+        
+        _T_ _container;
+};
+
+XSTestTyped( Success, XSTestTyped, XS::Test::Types< int, long, double > )
+{
+    TypeParam x( 42 );
+    
+    XSTestAssertEqual( x, static_cast< TypeParam >( 42 ) );
+}
+
+XSTestTypedFixture( XSTestTypedFixture, Back, XS::Test::Types< std::vector< int >, std::deque< int >, std::list< int > > )
+{
+    XSTestAssertEqual( this->_container.size(), static_cast< size_t >( 1 ) );
+    XSTestAssertEqual( this->_container.back(), 42 );
+}
+
+XSTest( Success, XSTestTypedNames )
+{
+    std::vector< std::string > names;
+    
+    for( const XS::Test::Registration * r = XS::Test::GetRegistry().GetFirst(); r != nullptr; r = r->GetNext() )
+    {
+        if( std::string( r->GetSuiteName() ) == "XSTestTypedFixture" )
+        {
+            names.push_back( r->GetCaseName() );
+        }
+    }
+    
+    XSTestAssertEqual( names.size(), static_cast< size_t >( 3 ) );
+    XSTestAssertStringEqual( names[ 0 ].c_str(), "Back/0" );
+    XSTestAssertStringEqual( names[ 2 ].c_str(), "Back/2" );
+    
+    {
+        char                argv0[] = "XSTest";
+        char                argv1[] = "--filter=XSTestTypedFixture.Back/1";
+        char              * argv[]  = { argv0, argv1 };
+        XS::Test::Arguments args( 2, argv );
+        
+        XSTestAssertTrue(  args.ShouldRun( "XSTestTypedFixture", names[ 1 ] ) );
+        XSTestAssertFalse( args.ShouldRun( "XSTestTypedFixture", names[ 0 ] ) );
+    }
+    
+    {
+        XS::Test::History history( "XSTestTypedNames.history" );
+        
+        history.SetDuration( "XSTestTypedFixture." + names[ 1 ], std::chrono::microseconds( 42 ) );
+        
+        XSTestAssertTrue( history.Save() );
+    }
+    
+    {
+        XS::Test::History history( "XSTestTypedNames.history" );
+        
+        std::remove( "XSTestTypedNames.history" );
+        
+        XSTestAssertTrue( history.GetDuration( "XSTestTypedFixture." + names[ 1 ] ).HasValue() );
+        XSTestAssertEqual( history.GetDuration( "XSTestTypedFixture." + names[ 1 ] )->count(), 42 );
+    }
+}
+
+XSTestTyped( Failure, XSTestTyped, XS::Test::Types< char, short > )
+{
+    XSTestAssertEqual( sizeof( TypeParam ), static_cast< size_t >( 4 ) );
+}
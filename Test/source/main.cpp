@@ -29,4 +29,5 @@
  */
 
 #define XSTEST_MAIN_RUN
+#define XSTEST_TRACK_ALLOCATIONS
 #include <XSTest/XSTest.hpp>
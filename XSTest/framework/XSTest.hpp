@@ -47,5 +47,24 @@
 #include <XSTest/TermColor.hpp>
 #include <XSTest/FloatingPoint.hpp>
 #include <XSTest/Arguments.hpp>
+#include <XSTest/ThreadPool.hpp>
+#include <XSTest/History.hpp>
+#include <XSTest/Isolation.hpp>
+#include <XSTest/Registration.hpp>
+#include <XSTest/Span.hpp>
+#include <XSTest/Statistics.hpp>
+#include <XSTest/Benchmark.hpp>
+#include <XSTest/Report.hpp>
+#include <XSTest/Filter.hpp>
+#include <XSTest/Allocations.hpp>
+#include <XSTest/ResourceUsage.hpp>
+#include <XSTest/Watchdog.hpp>
+#include <XSTest/Collector.hpp>
+#include <XSTest/Thread.hpp>
+#include <XSTest/Repetition.hpp>
+#include <XSTest/SuiteFixtures.hpp>
+#include <XSTest/Environment.hpp>
+#include <XSTest/Typed.hpp>
+#include <XSTest/Property.hpp>
 
 #endif /* XS_TEST_DYLIB_HPP */
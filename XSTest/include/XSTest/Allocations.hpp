@@ -0,0 +1,304 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Allocations.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_ALLOCATIONS_HPP
+#define XS_TEST_ALLOCATIONS_HPP
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Allocations
+        {
+            public:
+                
+                class Counters
+                {
+                    public:
+                        
+                        uint64_t count;
+                        uint64_t bytes;
+                        int64_t  live;
+                        int64_t  peak;
+                };
+                
+                Allocations():
+                    Allocations( 0, 0, 0 )
+                {}
+                
+                Allocations( uint64_t count, uint64_t bytes, uint64_t peak ):
+                    _count( count ),
+                    _bytes( bytes ),
+                    _peak(  peak )
+                {}
+                
+                Allocations( const Allocations & o ):
+                    _count( o._count ),
+                    _bytes( o._bytes ),
+                    _peak(  o._peak )
+                {}
+                
+                Allocations( Allocations && o ) noexcept:
+                    _count( std::move( o._count ) ),
+                    _bytes( std::move( o._bytes ) ),
+                    _peak(  std::move( o._peak ) )
+                {}
+                
+                ~Allocations()
+                {}
+                
+                Allocations & operator =( Allocations o )
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                static bool IsTracking() noexcept
+                {
+                    return Tracking();
+                }
+                
+                static void SetTracking( bool tracking ) noexcept
+                {
+                    Tracking() = tracking;
+                }
+                
+                static Counters Begin() noexcept
+                {
+                    Counters & counters( ThreadCounters() );
+                    Counters   begin( counters );
+                    
+                    counters.peak = counters.live;
+                    
+                    return begin;
+                }
+                
+                static Allocations End( const Counters & begin ) noexcept
+                {
+                    Counters  & counters( ThreadCounters() );
+                    Allocations allocations
+                    (
+                        counters.count - begin.count,
+                        counters.bytes - begin.bytes,
+                        static_cast< uint64_t >( std::max< int64_t >( counters.peak - begin.live, 0 ) )
+                    );
+                    
+                    /* Measures can be nested, so the peak of an enclosing measure is kept */
+                    counters.peak = std::max( counters.peak, begin.peak );
+                    
+                    return allocations;
+                }
+                
+                static void * Allocate( size_t size ) noexcept
+                {
+                    Counters & counters( ThreadCounters() );
+                    char     * p( static_cast< char * >( malloc( size + HeaderSize() ) ) );
+                    
+                    if( p == nullptr )
+                    {
+                        return nullptr;
+                    }
+                    
+                    /* The size is stored before the returned block, so live bytes can be tracked on deallocation */
+                    *( reinterpret_cast< size_t * >( p ) ) = size;
+                    
+                    counters.count += 1;
+                    counters.bytes += size;
+                    counters.live  += static_cast< int64_t >( size );
+                    counters.peak   = std::max( counters.peak, counters.live );
+                    
+                    return p + HeaderSize();
+                }
+                
+                static void Deallocate( void * data ) noexcept
+                {
+                    char * p( static_cast< char * >( data ) );
+                    
+                    if( p == nullptr )
+                    {
+                        return;
+                    }
+                    
+                    p -= HeaderSize();
+                    
+                    ThreadCounters().live -= static_cast< int64_t >( *( reinterpret_cast< size_t * >( p ) ) );
+                    
+                    free( p );
+                }
+                
+                uint64_t GetCount() const noexcept
+                {
+                    return this->_count;
+                }
+                
+                uint64_t GetBytes() const noexcept
+                {
+                    return this->_bytes;
+                }
+                
+                uint64_t GetPeak() const noexcept
+                {
+                    return this->_peak;
+                }
+                
+                friend void swap( Allocations & o1, Allocations & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._count, o2._count );
+                    swap( o1._bytes, o2._bytes );
+                    swap( o1._peak,  o2._peak );
+                }
+                
+            private:
+                
+                static bool & Tracking() noexcept
+                {
+                    static bool tracking( false );
+                    
+                    return tracking;
+                }
+                
+                static Counters & ThreadCounters() noexcept
+                {
+                    static thread_local Counters counters = { 0, 0, 0, 0 };
+                    
+                    return counters;
+                }
+                
+                static constexpr size_t HeaderSize() noexcept
+                {
+                    return ( alignof( std::max_align_t ) > sizeof( size_t ) ) ? alignof( std::max_align_t ) : sizeof( size_t );
+                }
+                
+                uint64_t _count;
+                uint64_t _bytes;
+                uint64_t _peak;
+        };
+    }
+}
+
+#if defined( XSTEST_TRACK_ALLOCATIONS ) && ( defined( XSTEST_MAIN ) || defined( XSTEST_MAIN_RUN ) )
+
+namespace XS
+{
+    namespace Test
+    {
+        inline void * AllocateOrThrow( size_t size )
+        {
+            while( true )
+            {
+                void           * p( Allocations::Allocate( size ) );
+                std::new_handler handler;
+                
+                if( p != nullptr )
+                {
+                    return p;
+                }
+                
+                handler = std::get_new_handler();
+                
+                if( handler == nullptr )
+                {
+                    throw std::bad_alloc();
+                }
+                
+                handler();
+            }
+        }
+        
+        static const bool TrackAllocations = ( Allocations::SetTracking( true ), true );
+    }
+}
+
+void * operator new( size_t size )
+{
+    return XS::Test::AllocateOrThrow( size );
+}
+
+void * operator new[]( size_t size )
+{
+    return XS::Test::AllocateOrThrow( size );
+}
+
+void * operator new( size_t size, const std::nothrow_t & ) noexcept
+{
+    return XS::Test::Allocations::Allocate( size );
+}
+
+void * operator new[]( size_t size, const std::nothrow_t & ) noexcept
+{
+    return XS::Test::Allocations::Allocate( size );
+}
+
+void operator delete( void * p ) noexcept
+{
+    XS::Test::Allocations::Deallocate( p );
+}
+
+void operator delete[]( void * p ) noexcept
+{
+    XS::Test::Allocations::Deallocate( p );
+}
+
+void operator delete( void * p, const std::nothrow_t & ) noexcept
+{
+    XS::Test::Allocations::Deallocate( p );
+}
+
+void operator delete[]( void * p, const std::nothrow_t & ) noexcept
+{
+    XS::Test::Allocations::Deallocate( p );
+}
+
+#ifdef __cpp_sized_deallocation
+
+void operator delete( void * p, size_t ) noexcept
+{
+    XS::Test::Allocations::Deallocate( p );
+}
+
+void operator delete[]( void * p, size_t ) noexcept
+{
+    XS::Test::Allocations::Deallocate( p );
+}
+
+#endif
+
+#endif
+
+#endif /* XS_TEST_ALLOCATIONS_HPP */
@@ -34,6 +34,15 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <XSTest/ThreadPool.hpp>
+#include <XSTest/Filter.hpp>
+#include <XSTest/Utility.hpp>
+#include <XSTest/Logging.hpp>
+#include <XSTest/TermColor.hpp>
 
 namespace XS
 {
@@ -43,24 +52,95 @@ namespace XS
         {
             public:
                 
-                Arguments( int argc, char * argv[] )
+                Arguments( int argc, char * argv[] ):
+                    _jobs(          1 ),
+                    _isolate(       false ),
+                    _flush(         Logging::FlushMode::Auto ),
+                    _quiet(         false ),
+                    _verbose(       false ),
+                    _color(         TermColor::Mode::Auto ),
+                    _shards(        ReadEnvironment( "XSTEST_TOTAL_SHARDS" ) ),
+                    _shard(         ReadEnvironment( "XSTEST_SHARD_INDEX" ) ),
+                    _seed(          Utility::RandomSeed() ),
+                    _shuffle(       true ),
+                    _timeout(       0 ),
+                    _globalTimeout( 0 ),
+                    _repeat(        0 ),
+                    _untilFail(     false ),
+                    _trials(        100 ),
+                    _propertyJobs(  1 )
                 {
                     std::string arg;
                     
+                    #ifdef XSTEST_GTEST_COMPAT
+                    
+                    if( getenv( "XSTEST_TOTAL_SHARDS" ) == nullptr )
+                    {
+                        this->_shards = ReadEnvironment( "GTEST_TOTAL_SHARDS" );
+                        this->_shard  = ReadEnvironment( "GTEST_SHARD_INDEX" );
+                    }
+                    
+                    #endif
+                    
                     for( int i = 1; i < argc; i++ )
                     {
                         arg = argv[ i ];
                         
-                        this->_tests.push_back( arg );
+                        if( arg.find( "--" ) == 0 )
+                        {
+                            this->ParseOption( arg.substr( 2 ) );
+                        }
+                        else
+                        {
+                            this->_filter.AddPositive( ( arg.find( '.' ) == std::string::npos ) ? arg + ".*" : arg );
+                        }
                     }
                 }
                 
                 Arguments( const Arguments & o ):
-                    _tests( o._tests )
+                    _filter(        o._filter ),
+                    _jobs(          o._jobs ),
+                    _history(       o._history ),
+                    _isolate(       o._isolate ),
+                    _flush(         o._flush ),
+                    _quiet(         o._quiet ),
+                    _verbose(       o._verbose ),
+                    _color(         o._color ),
+                    _junit(         o._junit ),
+                    _json(          o._json ),
+                    _shards(        o._shards ),
+                    _shard(         o._shard ),
+                    _seed(          o._seed ),
+                    _shuffle(       o._shuffle ),
+                    _timeout(       o._timeout ),
+                    _globalTimeout( o._globalTimeout ),
+                    _repeat(        o._repeat ),
+                    _untilFail(     o._untilFail ),
+                    _trials(        o._trials ),
+                    _propertyJobs(  o._propertyJobs )
                 {}
                 
                 Arguments( Arguments && o ) noexcept:
-                    _tests( std::move( o._tests ) )
+                    _filter(        std::move( o._filter ) ),
+                    _jobs(          std::move( o._jobs ) ),
+                    _history(       std::move( o._history ) ),
+                    _isolate(       std::move( o._isolate ) ),
+                    _flush(         std::move( o._flush ) ),
+                    _quiet(         std::move( o._quiet ) ),
+                    _verbose(       std::move( o._verbose ) ),
+                    _color(         std::move( o._color ) ),
+                    _junit(         std::move( o._junit ) ),
+                    _json(          std::move( o._json ) ),
+                    _shards(        std::move( o._shards ) ),
+                    _shard(         std::move( o._shard ) ),
+                    _seed(          std::move( o._seed ) ),
+                    _shuffle(       std::move( o._shuffle ) ),
+                    _timeout(       std::move( o._timeout ) ),
+                    _globalTimeout( std::move( o._globalTimeout ) ),
+                    _repeat(        std::move( o._repeat ) ),
+                    _untilFail(     std::move( o._untilFail ) ),
+                    _trials(        std::move( o._trials ) ),
+                    _propertyJobs(  std::move( o._propertyJobs ) )
                 {}
                 
                 ~Arguments()
@@ -73,36 +153,288 @@ namespace XS
                     return *( this );
                 }
                 
+                size_t GetJobs() const noexcept
+                {
+                    return this->_jobs;
+                }
+                
+                std::string GetHistory() const
+                {
+                    return this->_history;
+                }
+                
+                bool GetIsolate() const noexcept
+                {
+                    return this->_isolate;
+                }
+                
+                Logging::FlushMode GetFlushMode() const noexcept
+                {
+                    return this->_flush;
+                }
+                
+                bool GetQuiet() const noexcept
+                {
+                    return this->_quiet;
+                }
+                
+                bool GetVerbose() const noexcept
+                {
+                    return this->_verbose;
+                }
+                
+                TermColor::Mode GetColorMode() const noexcept
+                {
+                    return this->_color;
+                }
+                
+                std::string GetJUnit() const
+                {
+                    return this->_junit;
+                }
+                
+                std::string GetJSON() const
+                {
+                    return this->_json;
+                }
+                
+                size_t GetTotalShards() const noexcept
+                {
+                    return this->_shards;
+                }
+                
+                size_t GetShardIndex() const noexcept
+                {
+                    return this->_shard;
+                }
+                
+                uint32_t GetSeed() const noexcept
+                {
+                    return this->_seed;
+                }
+                
+                bool GetShuffle() const noexcept
+                {
+                    return this->_shuffle;
+                }
+                
+                std::chrono::milliseconds GetTimeout() const noexcept
+                {
+                    return this->_timeout;
+                }
+                
+                std::chrono::milliseconds GetGlobalTimeout() const noexcept
+                {
+                    return this->_globalTimeout;
+                }
+                
+                size_t GetRepeat() const noexcept
+                {
+                    return this->_repeat;
+                }
+                
+                bool GetUntilFail() const noexcept
+                {
+                    return this->_untilFail;
+                }
+                
+                size_t GetPropertyTrials() const noexcept
+                {
+                    return this->_trials;
+                }
+                
+                size_t GetPropertyJobs() const noexcept
+                {
+                    return this->_propertyJobs;
+                }
+                
                 bool ShouldRun( const std::string & testSuite, const std::string & testCase ) const
                 {
-                    if( this->_tests.size() == 0 )
-                    {
-                        return true;
-                    }
-                    
-                    if( std::find( std::begin( this->_tests ), std::end( this->_tests ), testSuite ) != std::end( this->_tests ) )
-                    {
-                        return true;
-                    }
-                    
-                    if( std::find( std::begin( this->_tests ), std::end( this->_tests ), testSuite + "." + testCase ) != std::end( this->_tests ) )
-                    {
-                        return true;
-                    }
-                    
-                    return false;
+                    return this->ShouldRun( testSuite.c_str(), testCase.c_str() );
+                }
+                
+                bool ShouldRun( const char * testSuite, const char * testCase ) const
+                {
+                    return this->_filter.Matches( testSuite, testCase );
                 }
                 
                 friend void swap( Arguments & o1, Arguments & o2 ) noexcept
                 {
                     using std::swap;
                     
-                    swap( o1._tests, o2._tests );
+                    swap( o1._filter,        o2._filter );
+                    swap( o1._jobs,          o2._jobs );
+                    swap( o1._history,       o2._history );
+                    swap( o1._isolate,       o2._isolate );
+                    swap( o1._flush,         o2._flush );
+                    swap( o1._quiet,         o2._quiet );
+                    swap( o1._verbose,       o2._verbose );
+                    swap( o1._color,         o2._color );
+                    swap( o1._junit,         o2._junit );
+                    swap( o1._json,          o2._json );
+                    swap( o1._shards,        o2._shards );
+                    swap( o1._shard,         o2._shard );
+                    swap( o1._seed,          o2._seed );
+                    swap( o1._shuffle,       o2._shuffle );
+                    swap( o1._timeout,       o2._timeout );
+                    swap( o1._globalTimeout, o2._globalTimeout );
+                    swap( o1._repeat,        o2._repeat );
+                    swap( o1._untilFail,     o2._untilFail );
+                    swap( o1._trials,        o2._trials );
+                    swap( o1._propertyJobs,  o2._propertyJobs );
                 }
                 
             private:
                 
-                std::vector< std::string > _tests;
+                static size_t ReadEnvironment( const char * name )
+                {
+                    const char * value( getenv( name ) );
+                    
+                    return ( value == nullptr ) ? 0 : static_cast< size_t >( std::strtoul( value, nullptr, 10 ) );
+                }
+                
+                static std::chrono::milliseconds ReadSeconds( const std::string & value )
+                {
+                    double seconds( std::strtod( value.c_str(), nullptr ) );
+                    
+                    return std::chrono::milliseconds( ( seconds > 0 ) ? static_cast< int64_t >( seconds * 1000 ) : 0 );
+                }
+                
+                void ParseOption( const std::string & option )
+                {
+                    std::string name( option.substr( 0, option.find( '=' ) ) );
+                    std::string value( ( name.length() < option.length() ) ? option.substr( name.length() + 1 ) : "" );
+                    
+                    if( name == "jobs" )
+                    {
+                        this->_jobs = static_cast< size_t >( std::strtoul( value.c_str(), nullptr, 10 ) );
+                        
+                        if( this->_jobs == 0 )
+                        {
+                            this->_jobs = ThreadPool::DefaultConcurrency();
+                        }
+                    }
+                    else if( name == "history" )
+                    {
+                        this->_history = ( value.length() > 0 ) ? value : ".xstest-history";
+                    }
+                    else if( name == "isolate" )
+                    {
+                        this->_isolate = true;
+                    }
+                    else if( name == "flush" )
+                    {
+                        if( value == "line" )
+                        {
+                            this->_flush = Logging::FlushMode::Line;
+                        }
+                        else if( value == "suite" )
+                        {
+                            this->_flush = Logging::FlushMode::Suite;
+                        }
+                        else
+                        {
+                            this->_flush = Logging::FlushMode::Auto;
+                        }
+                    }
+                    else if( name == "quiet" )
+                    {
+                        this->_quiet = true;
+                    }
+                    else if( name == "verbose" )
+                    {
+                        this->_verbose = true;
+                    }
+                    else if( name == "color" )
+                    {
+                        if( value == "always" )
+                        {
+                            this->_color = TermColor::Mode::Always;
+                        }
+                        else if( value == "never" )
+                        {
+                            this->_color = TermColor::Mode::Never;
+                        }
+                        else
+                        {
+                            this->_color = TermColor::Mode::Auto;
+                        }
+                    }
+                    else if( name == "filter" )
+                    {
+                        this->_filter.Add( value );
+                    }
+                    else if( name == "filter-regex" )
+                    {
+                        this->_filter.AddRegex( value );
+                    }
+                    else if( name == "seed" )
+                    {
+                        this->_seed = static_cast< uint32_t >( std::strtoul( value.c_str(), nullptr, 10 ) );
+                    }
+                    else if( name == "no-shuffle" )
+                    {
+                        this->_shuffle = false;
+                    }
+                    else if( name == "timeout" )
+                    {
+                        this->_timeout = ReadSeconds( value );
+                    }
+                    else if( name == "global-timeout" )
+                    {
+                        this->_globalTimeout = ReadSeconds( value );
+                    }
+                    else if( name == "repeat" )
+                    {
+                        this->_repeat = static_cast< size_t >( std::strtoul( value.c_str(), nullptr, 10 ) );
+                    }
+                    else if( name == "until-fail" )
+                    {
+                        this->_untilFail = true;
+                    }
+                    else if( name == "property-trials" )
+                    {
+                        this->_trials = static_cast< size_t >( std::strtoul( value.c_str(), nullptr, 10 ) );
+                    }
+                    else if( name == "property-jobs" )
+                    {
+                        this->_propertyJobs = static_cast< size_t >( std::strtoul( value.c_str(), nullptr, 10 ) );
+                        
+                        if( this->_propertyJobs == 0 )
+                        {
+                            this->_propertyJobs = ThreadPool::DefaultConcurrency();
+                        }
+                    }
+                    else if( name == "junit" )
+                    {
+                        this->_junit = ( value.length() > 0 ) ? value : "xstest.xml";
+                    }
+                    else if( name == "json" )
+                    {
+                        this->_json = ( value.length() > 0 ) ? value : "xstest.jsonl";
+                    }
+                }
+                
+                Filter                     _filter;
+                size_t                     _jobs;
+                std::string                _history;
+                bool                       _isolate;
+                Logging::FlushMode         _flush;
+                bool                       _quiet;
+                bool                       _verbose;
+                TermColor::Mode            _color;
+                std::string                _junit;
+                std::string                _json;
+                size_t                     _shards;
+                size_t                     _shard;
+                uint32_t                   _seed;
+                bool                       _shuffle;
+                std::chrono::milliseconds  _timeout;
+                std::chrono::milliseconds  _globalTimeout;
+                size_t                     _repeat;
+                bool                       _untilFail;
+                size_t                     _trials;
+                size_t                     _propertyJobs;
         };
     }
 }
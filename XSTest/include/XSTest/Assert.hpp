@@ -35,9 +35,14 @@
 #include <sstream>
 #include <cstring>
 #include <stdexcept>
-#include <functional>
 #include <type_traits>
+#include <cstdint>
+#include <utility>
+#include <atomic>
+#include <iostream>
 #include <XSTest/Failure.hpp>
+#include <XSTest/Collector.hpp>
+#include <XSTest/Allocations.hpp>
 #include <XSTest/Utility.hpp>
 #include <XSTest/FloatingPoint.hpp>
 
@@ -51,12 +56,36 @@ namespace XS
     {
         namespace Assert
         {
-            inline void Boolean( bool value, bool expected, const std::string & expression, const std::string & file, size_t line )
+            template< typename ... _A_ >
+            inline void Fail( bool fatal, _A_ && ... args )
+            {
+                Failure     failure( std::forward< _A_ >( args ) ... );
+                Collector * collector( Collector::Current() );
+                
+                /* Non-fatal failures are collected without unwinding, unless there's no test case to collect them */
+                if( fatal == false && collector != nullptr )
+                {
+                    collector->Add( std::move( failure ) );
+                    
+                    return;
+                }
+                
+                /* Non-fatal failures from threads that aren't linked to a test case go to the running test case */
+                if( fatal == false && Collector::AddToRunning( failure ) )
+                {
+                    return;
+                }
+                
+                throw failure;
+            }
+            
+            inline void Boolean( bool value, bool expected, const char * expression, const char * file, size_t line, bool fatal = true )
             {
                 if( value != expected )
                 {
-                    throw Failure
+                    Fail
                     (
+                        fatal,
                         expression,
                         ( expected ) ? "True" : "False",
                         ( value    ) ? "True" : "False",
@@ -66,12 +95,13 @@ namespace XS
                 } 
             }
             
-            inline void Boolean( bool value, bool expected, const std::string & expression, const std::string & evaluated, const std::string & file, size_t line )
+            inline void Boolean( bool value, bool expected, const char * expression, const std::string & evaluated, const char * file, size_t line, bool fatal = true )
             {
                 if( value != expected )
                 {
-                    throw Failure
+                    Fail
                     (
+                        fatal,
                         expression,
                         evaluated,
                         ( expected ) ? "True" : "False",
@@ -82,33 +112,26 @@ namespace XS
                 } 
             }
             
-            template< typename _T_, typename _U_ >
-            inline auto CompareEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
-                -> typename std::enable_if< ( std::is_integral< _T_ >::value && std::is_integral< _U_ >::value ) >::type
+            template< typename _T_ >
+            inline auto Describe( const _T_ & v )
+                -> typename std::enable_if< std::is_arithmetic< _T_ >::value, std::string >::type
             {
-                Boolean( v1 == v2, true, expression1 + " == " + expression2, std::to_string( v1 ) + " == " + std::to_string( v2 ), file, line );
+                return std::to_string( v );
             }
             
-            template< typename _T_, typename _U_ >
-            inline auto CompareNotEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
-                -> typename std::enable_if< ( std::is_integral< _T_ >::value && std::is_integral< _U_ >::value ) >::type
+            inline std::string Describe( const std::string & v )
             {
-                Boolean( v1 != v2, true, expression1 + " != " + expression2, std::to_string( v1 ) + " != " + std::to_string( v2 ), file, line );
+                return "\"" + v + "\"";
             }
             
-            template< typename _T_, typename _U_ >
-            inline auto CompareEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
-                -> typename std::enable_if< ( std::is_floating_point< _T_ >::value && std::is_floating_point< _U_ >::value ) >::type
+            inline void Comparison( bool result, const char * op, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
             {
-                FloatingPoint< _T_ > fp1( v1 );
-                FloatingPoint< _T_ > fp2( v2 );
-                
-                if( fp1 != fp2 )
+                if( result == false )
                 {
-                    throw Failure
+                    Fail
                     (
-                        expression1 + " == " + expression2,
-                        std::to_string( v1 ) + " == " + std::to_string( v2 ),
+                        fatal,
+                        std::string( expression1 ) + " " + op + " " + expression2,
                         "True",
                         "False",
                         file,
@@ -118,18 +141,15 @@ namespace XS
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareNotEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
-                -> typename std::enable_if< ( std::is_floating_point< _T_ >::value && std::is_floating_point< _U_ >::value ) >::type
+            inline void Comparison( bool result, const _T_ & v1, const _U_ & v2, const char * op, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
             {
-                FloatingPoint< _T_ > fp1( v1 );
-                FloatingPoint< _T_ > fp2( v2 );
-                
-                if( fp1 == fp2 )
+                if( result == false )
                 {
-                    throw Failure
+                    Fail
                     (
-                        expression1 + " != " + expression2,
-                        std::to_string( v1 ) + " != " + std::to_string( v2 ),
+                        fatal,
+                        std::string( expression1 ) + " " + op + " " + expression2,
+                        Describe( v1 ) + " " + op + " " + Describe( v2 ),
                         "True",
                         "False",
                         file,
@@ -139,7 +159,41 @@ namespace XS
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareLess( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
+                -> typename std::enable_if< ( std::is_integral< _T_ >::value && std::is_integral< _U_ >::value ) >::type
+            {
+                Comparison( v1 == v2, v1, v2, "==", expression1, expression2, file, line, fatal );
+            }
+            
+            template< typename _T_, typename _U_ >
+            inline auto CompareNotEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
+                -> typename std::enable_if< ( std::is_integral< _T_ >::value && std::is_integral< _U_ >::value ) >::type
+            {
+                Comparison( v1 != v2, v1, v2, "!=", expression1, expression2, file, line, fatal );
+            }
+            
+            template< typename _T_, typename _U_ >
+            inline auto CompareEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
+                -> typename std::enable_if< ( std::is_floating_point< _T_ >::value && std::is_floating_point< _U_ >::value ) >::type
+            {
+                FloatingPoint< _T_ > fp1( v1 );
+                FloatingPoint< _T_ > fp2( v2 );
+                
+                Comparison( fp1 == fp2, v1, v2, "==", expression1, expression2, file, line, fatal );
+            }
+            
+            template< typename _T_, typename _U_ >
+            inline auto CompareNotEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
+                -> typename std::enable_if< ( std::is_floating_point< _T_ >::value && std::is_floating_point< _U_ >::value ) >::type
+            {
+                FloatingPoint< _T_ > fp1( v1 );
+                FloatingPoint< _T_ > fp2( v2 );
+                
+                Comparison( fp1 != fp2, v1, v2, "!=", expression1, expression2, file, line, fatal );
+            }
+            
+            template< typename _T_, typename _U_ >
+            inline auto CompareLess( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                            ( std::is_integral< _T_ >::value       && std::is_integral< _U_ >::value )
@@ -147,11 +201,11 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 < v2, true, expression1 + " < " + expression2, std::to_string( v1 ) + " < " + std::to_string( v2 ), file, line );
+                Comparison( v1 < v2, v1, v2, "<", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareLessOrEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareLessOrEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                            ( std::is_integral< _T_ >::value       && std::is_integral< _U_ >::value )
@@ -159,11 +213,11 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 <= v2, true, expression1 + " <= " + expression2, std::to_string( v1 ) + " <= " + std::to_string( v2 ), file, line );
+                Comparison( v1 <= v2, v1, v2, "<=", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareGreater( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareGreater( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                            ( std::is_integral< _T_ >::value       && std::is_integral< _U_ >::value )
@@ -171,11 +225,11 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 > v2, true, expression1 + " > " + expression2, std::to_string( v1 ) + " > " + std::to_string( v2 ), file, line );
+                Comparison( v1 > v2, v1, v2, ">", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareGreaterOrEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareGreaterOrEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                            ( std::is_integral< _T_ >::value       && std::is_integral< _U_ >::value )
@@ -183,53 +237,53 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 >= v2, true, expression1 + " >= " + expression2, std::to_string( v1 ) + " >= " + std::to_string( v2 ), file, line );
+                Comparison( v1 >= v2, v1, v2, ">=", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if< ( std::is_same< _T_, std::string >::value && std::is_same< _U_, std::string >::value ) > ::type
             {
-                Boolean( v1 == v2, true, expression1 + " == " + expression2, "\"" + v1 + "\" == \"" + v2 + "\"", file, line );
+                Comparison( v1 == v2, v1, v2, "==", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareNotEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareNotEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if< ( std::is_same< _T_, std::string >::value && std::is_same< _U_, std::string >::value ) > ::type
             {
-                Boolean( v1 != v2, true, expression1 + " != " + expression2, "\"" + v1 + "\" != \"" + v2 + "\"", file, line );
+                Comparison( v1 != v2, v1, v2, "!=", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareLess( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareLess( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if< ( std::is_same< _T_, std::string >::value && std::is_same< _U_, std::string >::value ) > ::type
             {
-                Boolean( v1 < v2, true, expression1 + " < " + expression2, "\"" + v1 + "\" < \"" + v2 + "\"", file, line );
+                Comparison( v1 < v2, v1, v2, "<", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareLessOrEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareLessOrEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if< ( std::is_same< _T_, std::string >::value && std::is_same< _U_, std::string >::value ) > ::type
             {
-                Boolean( v1 <= v2, true, expression1 + " <= " + expression2, "\"" + v1 + "\" <= \"" + v2 + "\"", file, line );
+                Comparison( v1 <= v2, v1, v2, "<=", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareGreater( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareGreater( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if< ( std::is_same< _T_, std::string >::value && std::is_same< _U_, std::string >::value ) > ::type
             {
-                Boolean( v1 > v2, true, expression1 + " > " + expression2, "\"" + v1 + " \"> \"" + v2 + "\"", file, line );
+                Comparison( v1 > v2, v1, v2, ">", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareGreaterOrEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareGreaterOrEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if< ( std::is_same< _T_, std::string >::value && std::is_same< _U_, std::string >::value ) > ::type
             {
-                Boolean( v1 >= v2, true, expression1 + " >= " + expression2, "\"" + v1 + "\" >= \"" + v2 + "\"", file, line );
+                Comparison( v1 >= v2, v1, v2, ">=", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                           ( !std::is_integral< _T_ >::value          || !std::is_integral< _U_ >::value )
@@ -238,11 +292,11 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 == v2, true, expression1 + " == " + expression2, file, line );
+                Comparison( v1 == v2, "==", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareNotEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareNotEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                           ( !std::is_integral< _T_ >::value          || !std::is_integral< _U_ >::value )
@@ -251,11 +305,11 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 != v2, true, expression1 + " != " + expression2, file, line );
+                Comparison( v1 != v2, "!=", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareLess( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareLess( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                           ( !std::is_integral< _T_ >::value          || !std::is_integral< _U_ >::value )
@@ -264,11 +318,11 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 < v2, true, expression1 + " < " + expression2, file, line );
+                Comparison( v1 < v2, "<", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareLessOrEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareLessOrEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                           ( !std::is_integral< _T_ >::value          || !std::is_integral< _U_ >::value )
@@ -277,11 +331,11 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 <= v2, true, expression1 + " <= " + expression2, file, line );
+                Comparison( v1 <= v2, "<=", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareGreater( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareGreater( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                           ( !std::is_integral< _T_ >::value          || !std::is_integral< _U_ >::value )
@@ -290,11 +344,11 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 > v2, true, expression1 + " > " + expression2, file, line );
+                Comparison( v1 > v2, ">", expression1, expression2, file, line, fatal );
             }
             
             template< typename _T_, typename _U_ >
-            inline auto CompareGreaterOrEqual( const _T_ & v1, const _U_ & v2, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline auto CompareGreaterOrEqual( const _T_ & v1, const _U_ & v2, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if
                    <
                           ( !std::is_integral< _T_ >::value          || !std::is_integral< _U_ >::value )
@@ -303,10 +357,10 @@ namespace XS
                    >
                    ::type
             {
-                Boolean( v1 >= v2, true, expression1 + " >= " + expression2, file, line );
+                Comparison( v1 >= v2, ">=", expression1, expression2, file, line, fatal );
             }
             
-            inline void StringEquality( const char * cp1, const char * cp2, bool expected, bool caseInsensitive, const std::string & expression1, const std::string & expression2, const std::string & file, size_t line )
+            inline void StringEquality( const char * cp1, const char * cp2, bool expected, bool caseInsensitive, const char * expression1, const char * expression2, const char * file, size_t line, bool fatal = true )
             {
                 bool result;
                 
@@ -332,16 +386,16 @@ namespace XS
                     {
                         std::string s1( ( cp1 == nullptr ) ? "NULL" : "\"" + std::string( cp1 ) + "\"" );
                         std::string s2( ( cp2 == nullptr ) ? "NULL" : "\"" + std::string( cp2 ) + "\"" );
-                        std::string expression( ( expected ) ? expression1 + " == " + expression2 : expression1 + " != " + expression2 );
-                        std::string evaluated(  ( expected ) ? s1          + " == " + s2          : s1          + " != " + s2 );
+                        std::string expression( std::string( expression1 ) + ( ( expected ) ? " == " : " != " ) + expression2 );
+                        std::string evaluated(  s1                          + ( ( expected ) ? " == " : " != " ) + s2 );
                         
-                        Boolean( result, expected, expression, evaluated, file, line );
+                        Boolean( result, expected, expression.c_str(), evaluated, file, line, fatal );
                     }
                 }
             }
             
-            template< typename _T_ >
-            inline auto Throwing( const std::function< void() > & f, const std::string & exception, const std::string & expression, const std::string & file, size_t line )
+            template< typename _T_, typename _F_ >
+            inline auto Throwing( const _F_ & f, const char * exception, const char * expression, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if< !std::is_base_of< std::exception, _T_ >::value || !std::is_same< std::exception, _T_ >::value >::type
             {
                 bool        hasCaught( false );
@@ -351,10 +405,7 @@ namespace XS
                 
                 try
                 {
-                    if( f != nullptr )
-                    {
-                        f();
-                    }
+                    f();
                 }
                 catch( const _T_ & e )
                 {
@@ -376,10 +427,11 @@ namespace XS
                 
                 if( hasThrown == false || hasCaught == false )
                 {
-                    throw Failure
+                    Fail
                     (
+                        fatal,
                         expression,
-                        "Throws " + exception,
+                        std::string( "Throws " ) + exception,
                         ( hasThrown == false ) ? "Doesn't throw anything" : ( ( thrown.length() == 0 ) ? "Throws a different exception" : "Throws " + thrown ),
                         file,
                         line
@@ -387,8 +439,8 @@ namespace XS
                 }
             }
             
-            template< typename _T_ >
-            inline auto Throwing( const std::function< void() > & f, const std::string & exception, const std::string & expression, const std::string & file, size_t line )
+            template< typename _T_, typename _F_ >
+            inline auto Throwing( const _F_ & f, const char * exception, const char * expression, const char * file, size_t line, bool fatal = true )
                 -> typename std::enable_if< !( !std::is_base_of< std::exception, _T_ >::value || !std::is_same< std::exception, _T_ >::value ) >::type
             {
                 bool hasCaught( false );
@@ -396,10 +448,7 @@ namespace XS
                 
                 try
                 {
-                    if( f != nullptr )
-                    {
-                        f();
-                    }
+                    f();
                 }
                 catch( const _T_ & e )
                 {
@@ -415,10 +464,11 @@ namespace XS
                 
                 if( hasThrown == false || hasCaught == false )
                 {
-                    throw Failure
+                    Fail
                     (
+                        fatal,
                         expression,
-                        "Throws " + exception,
+                        std::string( "Throws " ) + exception,
                         ( hasThrown == false ) ? "Doesn't throw anything" : "Throws a different exception",
                         file,
                         line
@@ -426,7 +476,8 @@ namespace XS
                 }
             }
             
-            inline void Throwing( const std::function< void() > & f, bool throws, const std::string & expression, const std::string & file, size_t line )
+            template< typename _F_ >
+            inline void Throwing( const _F_ & f, bool throws, const char * expression, const char * file, size_t line, bool fatal = true )
             {
                 bool        hasThrown( false );
                 std::string thrown;
@@ -434,10 +485,7 @@ namespace XS
                 
                 try
                 {
-                    if( f != nullptr )
-                    {
-                        f();
-                    }
+                    f();
                 }
                 catch( const std::exception & e )
                 {
@@ -452,8 +500,9 @@ namespace XS
                 
                 if( hasThrown != throws )
                 {
-                    throw Failure
+                    Fail
                     (
+                        fatal,
                         expression,
                         ( throws ) ? "Throws an exception"    : "Doesn't throw any exception",
                         ( throws ) ? "Doesn't throw anything" : ( ( thrown.length() == 0 ) ? "Throws an exception" : "Throws " + thrown ),
@@ -463,12 +512,80 @@ namespace XS
                 }
             }
             
+            inline void SkipMaxAllocations( const char * expression, const char * file, size_t line )
+            {
+                static std::atomic< bool > warned( false );
+                
+                if( warned.exchange( true ) == false )
+                {
+                    std::cerr << "Allocation tracking is disabled (XSTEST_TRACK_ALLOCATIONS is not defined), skipping allocation checks like " << expression << " at " << file << ":" << line << std::endl;
+                }
+            }
+            
+            /*
+             * Allocations are counted per thread, so allocations made by
+             * threads started from the expression are not counted.
+             */
+            template< typename _F_ >
+            inline void MaxAllocations( const _F_ & f, uint64_t max, const char * expression, const char * file, size_t line, bool fatal = true )
+            {
+                class Measure
+                {
+                    public:
+                        
+                        explicit Measure( Allocations & allocations ):
+                            _allocations( allocations ),
+                            _begin( Allocations::Begin() )
+                        {}
+                        
+                        /* Ends the measure even if the expression throws, so nested measures stay balanced */
+                        ~Measure()
+                        {
+                            this->_allocations = Allocations::End( this->_begin );
+                        }
+                        
+                        Measure( const Measure & o )              = delete;
+                        Measure & operator =( const Measure & o ) = delete;
+                        
+                    private:
+                        
+                        Allocations         & _allocations;
+                        Allocations::Counters _begin;
+                };
+                
+                Allocations allocations;
+                
+                if( Allocations::IsTracking() == false )
+                {
+                    /* Without tracking, the expression is still evaluated, but the check is skipped */
+                    SkipMaxAllocations( expression, file, line );
+                    
+                    f();
+                    
+                    return;
+                }
+                
+                {
+                    Measure measure( allocations );
+                    
+                    f();
+                }
+                
+                if( allocations.GetCount() > max )
+                {
+                    Fail( fatal, expression, "At most " + Utility::Numbered( "allocation", static_cast< size_t >( max ) ), Utility::Numbered( "allocation", static_cast< size_t >( allocations.GetCount() ) ) + " (" + Utility::Numbered( "byte", static_cast< size_t >( allocations.GetBytes() ) ) + ")", file, line );
+                }
+            }
+            
             #ifdef _WIN32
-            inline void HResult( HRESULT hr, bool expected, const std::string & expression, const std::string & file, size_t line )
+            inline void HResult( HRESULT hr, bool expected, const char * expression, const char * file, size_t line, bool fatal = true )
             {
                 bool result( ( expected == true && SUCCEEDED( hr ) ) || ( expected == false && FAILED( hr ) ) );
                 
-                Boolean( result, expected, expression, std::to_string( hr ), file, line );
+                if( result != expected )
+                {
+                    Boolean( result, expected, expression, std::to_string( hr ), file, line, fatal );
+                }
             }
             #endif
         }
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Benchmark.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_BENCHMARK_HPP
+#define XS_TEST_BENCHMARK_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <XSTest/Statistics.hpp>
+
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#include <intrin.h>
+#endif
+
+namespace XS
+{
+    namespace Test
+    {
+        class Benchmark
+        {
+            public:
+                
+                template< typename _F_ >
+                static Benchmark Run( _F_ f, std::chrono::nanoseconds sampleTime = std::chrono::milliseconds( 10 ), size_t samples = 20 )
+                {
+                    size_t                iterations( 1 );
+                    double                target( static_cast< double >( sampleTime.count() ) );
+                    double                elapsed;
+                    std::vector< double > times;
+                    
+                    for( ;; )
+                    {
+                        elapsed = Time( f, iterations );
+                        
+                        if( elapsed >= target || iterations >= MaxIterations() )
+                        {
+                            break;
+                        }
+                        
+                        if( elapsed < target / 10 )
+                        {
+                            iterations *= 10;
+                        }
+                        else
+                        {
+                            iterations = static_cast< size_t >( static_cast< double >( iterations ) * ( target / elapsed ) * 1.1 ) + 1;
+                        }
+                        
+                        iterations = std::min( iterations, MaxIterations() );
+                    }
+                    
+                    Time( f, iterations );
+                    
+                    times.reserve( samples );
+                    
+                    for( size_t i = 0; i < samples; i++ )
+                    {
+                        times.push_back( Time( f, iterations ) / static_cast< double >( iterations ) );
+                    }
+                    
+                    return Benchmark( iterations, Statistics( std::move( times ) ) );
+                }
+                
+                template< typename _T_ >
+                static void DoNotOptimize( const _T_ & value )
+                {
+                    #if defined( _MSC_VER ) && !defined( __clang__ )
+                    
+                    const volatile char * p( reinterpret_cast< const volatile char * >( &value ) );
+                    
+                    ( void )*( p );
+                    
+                    _ReadWriteBarrier();
+                    
+                    #else
+                    
+                    asm volatile( "" : : "r,m"( value ) : "memory" );
+                    
+                    #endif
+                }
+                
+                static std::string FormatTime( double nanoseconds )
+                {
+                    if( nanoseconds < 1e3 )
+                    {
+                        return Format( nanoseconds, "ns" );
+                    }
+                    else if( nanoseconds < 1e6 )
+                    {
+                        return Format( nanoseconds / 1e3, "us" );
+                    }
+                    else if( nanoseconds < 1e9 )
+                    {
+                        return Format( nanoseconds / 1e6, "ms" );
+                    }
+                    
+                    return Format( nanoseconds / 1e9, "s" );
+                }
+                
+                static std::string FormatRate( double perSecond )
+                {
+                    if( perSecond < 1e3 )
+                    {
+                        return Format( perSecond, "/s" );
+                    }
+                    else if( perSecond < 1e6 )
+                    {
+                        return Format( perSecond / 1e3, "K/s" );
+                    }
+                    else if( perSecond < 1e9 )
+                    {
+                        return Format( perSecond / 1e6, "M/s" );
+                    }
+                    
+                    return Format( perSecond / 1e9, "G/s" );
+                }
+                
+                Benchmark( size_t iterations, Statistics statistics ):
+                    _iterations( iterations ),
+                    _statistics( std::move( statistics ) )
+                {}
+                
+                Benchmark( const Benchmark & o ):
+                    _iterations( o._iterations ),
+                    _statistics( o._statistics )
+                {}
+                
+                Benchmark( Benchmark && o ) noexcept:
+                    _iterations( std::move( o._iterations ) ),
+                    _statistics( std::move( o._statistics ) )
+                {}
+                
+                ~Benchmark()
+                {}
+                
+                Benchmark & operator =( Benchmark o )
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                size_t GetIterations() const noexcept
+                {
+                    return this->_iterations;
+                }
+                
+                const Statistics & GetStatistics() const noexcept
+                {
+                    return this->_statistics;
+                }
+                
+                double GetThroughput() const noexcept
+                {
+                    return ( this->_statistics.GetMean() > 0 ) ? 1e9 / this->_statistics.GetMean() : 0;
+                }
+                
+                friend void swap( Benchmark & o1, Benchmark & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._iterations, o2._iterations );
+                    swap( o1._statistics, o2._statistics );
+                }
+                
+            private:
+                
+                static size_t MaxIterations()
+                {
+                    return static_cast< size_t >( 1 ) << 30;
+                }
+                
+                template< typename _F_ >
+                static double Time( _F_ & f, size_t iterations )
+                {
+                    std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+                    
+                    for( size_t i = 0; i < iterations; i++ )
+                    {
+                        f();
+                    }
+                    
+                    return static_cast< double >( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start ).count() );
+                }
+                
+                static std::string Format( double value, const char * unit )
+                {
+                    char buffer[ 64 ];
+                    
+                    snprintf( buffer, sizeof( buffer ), "%.2f %s", value, unit );
+                    
+                    return buffer;
+                }
+                
+                size_t     _iterations;
+                Statistics _statistics;
+        };
+    }
+}
+
+#endif /* XS_TEST_BENCHMARK_HPP */
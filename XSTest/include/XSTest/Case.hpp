@@ -31,6 +31,9 @@
 #ifndef XS_TEST_CASE_HPP
 #define XS_TEST_CASE_HPP
 
+#include <XSTest/Optional.hpp>
+#include <XSTest/Benchmark.hpp>
+
 namespace XS
 {
     namespace Test
@@ -41,12 +44,20 @@ namespace XS
         {
             public:
                 
-                Case()          = default;
+                Case(): _info( nullptr )
+                {}
+                
                 virtual ~Case() = default;
                 
                 Case( const Case & o )              = delete;
                 Case & operator =( const Case & o ) = delete;
                 
+                static void SetUpTestSuite()
+                {}
+                
+                static void TearDownTestSuite()
+                {}
+                
             protected:
                 
                 virtual void SetUp()
@@ -57,8 +68,23 @@ namespace XS
                 
                 friend class Info;
                 
-                virtual const Info & Info() = 0;
-                virtual void         Test() = 0;
+                virtual const Info & Info()
+                {
+                    return *( this->_info );
+                }
+                
+                virtual void Test() = 0;
+                
+                template< typename _F_ >
+                void RunBenchmark( _F_ f )
+                {
+                    this->_benchmark = Benchmark::Run( f );
+                }
+                
+            private:
+                
+                const class Info *    _info;
+                Optional< Benchmark > _benchmark;
         };
     }
 }
@@ -0,0 +1,269 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Collector.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_COLLECTOR_HPP
+#define XS_TEST_COLLECTOR_HPP
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <mutex>
+#include <XSTest/Failure.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Collector
+        {
+            private:
+                
+                class List;
+                
+            public:
+                
+                class Scope
+                {
+                    public:
+                        
+                        explicit Scope( Collector & collector ):
+                            _previous( Current() )
+                        {
+                            CurrentPointer() = &collector;
+                        }
+                        
+                        ~Scope()
+                        {
+                            CurrentPointer() = this->_previous;
+                        }
+                        
+                        Scope( const Scope & o )              = delete;
+                        Scope & operator =( const Scope & o ) = delete;
+                        
+                    private:
+                        
+                        Collector * _previous;
+                };
+                
+                class Running
+                {
+                    public:
+                        
+                        explicit Running( const Collector & collector ):
+                            _list( collector._list )
+                        {
+                            std::lock_guard< std::mutex > lock( RunningMutex() );
+                            
+                            RunningLists().push_back( this->_list );
+                        }
+                        
+                        ~Running()
+                        {
+                            std::lock_guard< std::mutex > lock( RunningMutex() );
+                            
+                            std::vector< std::shared_ptr< List > > & lists( RunningLists() );
+                            
+                            lists.erase( std::find( lists.begin(), lists.end(), this->_list ) );
+                        }
+                        
+                        Running( const Running & o )              = delete;
+                        Running & operator =( const Running & o ) = delete;
+                        
+                    private:
+                        
+                        std::shared_ptr< List > _list;
+                };
+                
+                Collector():
+                    _list( std::make_shared< List >() )
+                {}
+                
+                /* Copies share the same failures, so a thread can keep collecting even if the original collector is gone */
+                Collector( const Collector & o ):
+                    _list( o._list )
+                {}
+                
+                Collector( Collector && o ) noexcept:
+                    _list( std::move( o._list ) )
+                {}
+                
+                ~Collector()
+                {}
+                
+                Collector & operator =( Collector o )
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                static Collector * Current() noexcept
+                {
+                    return CurrentPointer();
+                }
+                
+                /* Threads that aren't linked to a test case report to the last test case started, if one is still running */
+                static bool AddToRunning( const Failure & failure )
+                {
+                    std::shared_ptr< List > list;
+                    
+                    {
+                        std::lock_guard< std::mutex > lock( RunningMutex() );
+                        
+                        if( RunningLists().empty() )
+                        {
+                            return false;
+                        }
+                        
+                        list = RunningLists().back();
+                    }
+                    
+                    Collector( std::move( list ) ).Add( failure );
+                    
+                    return true;
+                }
+                
+                void Add( Failure failure )
+                {
+                    Node * node( new Node( std::move( failure ) ) );
+                    
+                    node->next = this->_list->head.load( std::memory_order_relaxed );
+                    
+                    /* Failures can be added from any thread spawned by the test case, without locking */
+                    while( this->_list->head.compare_exchange_weak( node->next, node, std::memory_order_release, std::memory_order_relaxed ) == false )
+                    {}
+                    
+                    this->_list->count.fetch_add( 1, std::memory_order_relaxed );
+                }
+                
+                size_t GetCount() const noexcept
+                {
+                    return this->_list->count.load( std::memory_order_relaxed );
+                }
+                
+                std::vector< Failure > GetFailures() const
+                {
+                    std::vector< Failure > failures;
+                    
+                    for( const Node * node = this->_list->head.load( std::memory_order_acquire ); node != nullptr; node = node->next )
+                    {
+                        failures.push_back( node->failure );
+                    }
+                    
+                    std::reverse( failures.begin(), failures.end() );
+                    
+                    return failures;
+                }
+                
+                friend void swap( Collector & o1, Collector & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._list, o2._list );
+                }
+                
+            private:
+                
+                class Node
+                {
+                    public:
+                        
+                        explicit Node( Failure f ):
+                            failure( std::move( f ) ),
+                            next(    nullptr )
+                        {}
+                        
+                        Failure failure;
+                        Node  * next;
+                };
+                
+                class List
+                {
+                    public:
+                        
+                        List():
+                            head(  nullptr ),
+                            count( 0 )
+                        {}
+                        
+                        ~List()
+                        {
+                            Node * node( this->head.load() );
+                            
+                            while( node != nullptr )
+                            {
+                                Node * next( node->next );
+                                
+                                delete node;
+                                
+                                node = next;
+                            }
+                        }
+                        
+                        List( const List & o )              = delete;
+                        List & operator =( const List & o ) = delete;
+                        
+                        std::atomic< Node * > head;
+                        std::atomic< size_t > count;
+                };
+                
+                explicit Collector( std::shared_ptr< List > list ):
+                    _list( std::move( list ) )
+                {}
+                
+                static Collector *& CurrentPointer() noexcept
+                {
+                    static thread_local Collector * current( nullptr );
+                    
+                    return current;
+                }
+                
+                static std::vector< std::shared_ptr< List > > & RunningLists()
+                {
+                    static std::vector< std::shared_ptr< List > > lists;
+                    
+                    return lists;
+                }
+                
+                static std::mutex & RunningMutex()
+                {
+                    static std::mutex mutex;
+                    
+                    return mutex;
+                }
+                
+                std::shared_ptr< List > _list;
+        };
+    }
+}
+
+#endif /* XS_TEST_COLLECTOR_HPP */
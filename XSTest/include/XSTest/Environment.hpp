@@ -0,0 +1,235 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Environment.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_ENVIRONMENT_HPP
+#define XS_TEST_ENVIRONMENT_HPP
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Environment
+        {
+            public:
+                
+                class Releasable
+                {
+                    public:
+                        
+                        virtual ~Releasable()
+                        {}
+                        
+                        virtual void Release() = 0;
+                };
+                
+                template< typename _T_ >
+                class Resource: public Releasable
+                {
+                    public:
+                        
+                        Resource( const char * name, std::shared_ptr< _T_ > ( * create )() ) noexcept:
+                            _name(    name ),
+                            _create(  create ),
+                            _created( false )
+                        {}
+                        
+                        Resource( const Resource & o )              = delete;
+                        Resource & operator =( const Resource & o ) = delete;
+                        
+                        const char * GetName() const noexcept
+                        {
+                            return this->_name;
+                        }
+                        
+                        std::shared_ptr< _T_ > Get()
+                        {
+                            std::lock_guard< std::mutex > l( this->_mutex );
+                            
+                            /* Concurrent users wait for the resource to be created, which only happens once, even if the creation failed */
+                            if( this->_created == false )
+                            {
+                                this->_instance = this->_create();
+                                this->_created  = true;
+                                
+                                if( this->_instance != nullptr )
+                                {
+                                    Environment::Created( *( this ) );
+                                }
+                            }
+                            
+                            return this->_instance;
+                        }
+                        
+                        /* A released resource is created again if it's used later, while a failed creation is kept */
+                        void Release() override
+                        {
+                            std::shared_ptr< _T_ > instance;
+                            
+                            {
+                                std::lock_guard< std::mutex > l( this->_mutex );
+                                
+                                if( this->_instance != nullptr )
+                                {
+                                    std::swap( instance, this->_instance );
+                                    
+                                    this->_created = false;
+                                }
+                            }
+                        }
+                        
+                    private:
+                        
+                        const char *             _name;
+                        std::shared_ptr< _T_ > ( * _create )();
+                        bool                     _created;
+                        std::mutex               _mutex;
+                        std::shared_ptr< _T_ >   _instance;
+                };
+                
+                /* Declares that the test cases of a suite use a resource, so it can be released once the last of them has run */
+                class Use
+                {
+                    public:
+                        
+                        Use( const char * suite, Releasable & resource )
+                        {
+                            std::lock_guard< std::mutex > l( SharedState().mutex );
+                            
+                            SharedState().uses.push_back( { suite, &resource } );
+                        }
+                        
+                        Use( const Use & o )              = delete;
+                        Use & operator =( const Use & o ) = delete;
+                };
+                
+                Environment() = delete;
+                
+                static void AddUsers( const char * suite, size_t count )
+                {
+                    std::lock_guard< std::mutex > l( SharedState().mutex );
+                    
+                    for( const auto & use: SharedState().uses )
+                    {
+                        if( strcmp( use.first, suite ) == 0 )
+                        {
+                            SharedState().users[ use.second ] += count;
+                        }
+                    }
+                }
+                
+                static void RemoveUser( const char * suite )
+                {
+                    std::vector< Releasable * > unused;
+                    
+                    {
+                        std::lock_guard< std::mutex > l( SharedState().mutex );
+                        
+                        for( const auto & use: SharedState().uses )
+                        {
+                            auto i( SharedState().users.find( use.second ) );
+                            
+                            if( strcmp( use.first, suite ) != 0 || i == SharedState().users.end() || --( i->second ) > 0 )
+                            {
+                                continue;
+                            }
+                            
+                            SharedState().users.erase( i );
+                            SharedState().created.erase( std::remove( SharedState().created.begin(), SharedState().created.end(), use.second ), SharedState().created.end() );
+                            unused.push_back( use.second );
+                        }
+                    }
+                    
+                    for( const auto & resource: unused )
+                    {
+                        resource->Release();
+                    }
+                }
+                
+                static void TearDown()
+                {
+                    std::vector< Releasable * > created;
+                    
+                    {
+                        std::lock_guard< std::mutex > l( SharedState().mutex );
+                        
+                        std::swap( created, SharedState().created );
+                        SharedState().users.clear();
+                    }
+                    
+                    /* Resources are released in reverse order, as a resource may use the ones created before it */
+                    std::reverse( created.begin(), created.end() );
+                    
+                    for( const auto & resource: created )
+                    {
+                        resource->Release();
+                    }
+                }
+                
+            private:
+                
+                class State
+                {
+                    public:
+                        
+                        std::mutex                                             mutex;
+                        std::vector< Releasable * >                            created;
+                        std::vector< std::pair< const char *, Releasable * > > uses;
+                        std::map< Releasable *, size_t >                       users;
+                };
+                
+                static State & SharedState()
+                {
+                    static State state;
+                    
+                    return state;
+                }
+                
+                static void Created( Releasable & resource )
+                {
+                    std::lock_guard< std::mutex > l( SharedState().mutex );
+                    
+                    if( std::find( SharedState().created.begin(), SharedState().created.end(), &resource ) == SharedState().created.end() )
+                    {
+                        SharedState().created.push_back( &resource );
+                    }
+                }
+        };
+    }
+}
+
+#endif /* XS_TEST_ENVIRONMENT_HPP */
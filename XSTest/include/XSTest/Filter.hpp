@@ -0,0 +1,391 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Filter.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_FILTER_HPP
+#define XS_TEST_FILTER_HPP
+
+#include <string>
+#include <vector>
+#include <regex>
+#include <cstring>
+#include <algorithm>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Filter
+        {
+            public:
+                
+                Filter():
+                    _invalid( false )
+                {}
+                
+                Filter( const Filter & o ):
+                    _positive( o._positive ),
+                    _negative( o._negative ),
+                    _regexes(  o._regexes ),
+                    _invalid(  o._invalid )
+                {}
+                
+                Filter( Filter && o ) noexcept:
+                    _positive( std::move( o._positive ) ),
+                    _negative( std::move( o._negative ) ),
+                    _regexes(  std::move( o._regexes ) ),
+                    _invalid(  std::move( o._invalid ) )
+                {}
+                
+                ~Filter()
+                {}
+                
+                Filter & operator =( Filter o )
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                void Add( const std::string & filter )
+                {
+                    size_t negative( filter.find( '-' ) );
+                    
+                    Split( filter.substr( 0, negative ), this->_positive );
+                    
+                    if( negative != std::string::npos )
+                    {
+                        Split( filter.substr( negative + 1 ), this->_negative );
+                    }
+                }
+                
+                void AddPositive( const std::string & pattern )
+                {
+                    this->_positive.Add( pattern );
+                }
+                
+                void AddNegative( const std::string & pattern )
+                {
+                    this->_negative.Add( pattern );
+                }
+                
+                void AddRegex( const std::string & pattern )
+                {
+                    try
+                    {
+                        this->_regexes.push_back( std::regex( pattern, std::regex::ECMAScript | std::regex::optimize ) );
+                    }
+                    catch( const std::regex_error & )
+                    {
+                        this->_invalid = true;
+                    }
+                }
+                
+                bool Matches( const char * testSuite, const char * testCase ) const
+                {
+                    Name name( testSuite, testCase );
+                    
+                    if( this->_invalid )
+                    {
+                        return false;
+                    }
+                    
+                    if( this->_negative.Matches( name ) )
+                    {
+                        return false;
+                    }
+                    
+                    if( this->_positive.IsEmpty() && this->_regexes.size() == 0 )
+                    {
+                        return true;
+                    }
+                    
+                    if( this->_positive.Matches( name ) )
+                    {
+                        return true;
+                    }
+                    
+                    if( this->_regexes.size() > 0 )
+                    {
+                        std::string s( name.GetString() );
+                        
+                        for( const auto & regex: this->_regexes )
+                        {
+                            if( std::regex_match( s, regex ) )
+                            {
+                                return true;
+                            }
+                        }
+                    }
+                    
+                    return false;
+                }
+                
+                friend void swap( Filter & o1, Filter & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._positive, o2._positive );
+                    swap( o1._negative, o2._negative );
+                    swap( o1._regexes,  o2._regexes );
+                    swap( o1._invalid,  o2._invalid );
+                }
+                
+            private:
+                
+                /* Full test name, as "Suite.Case", without concatenating the strings */
+                class Name
+                {
+                    public:
+                        
+                        Name( const char * testSuite, const char * testCase ):
+                            _suite(       testSuite ),
+                            _case(        testCase ),
+                            _suiteLength( strlen( testSuite ) ),
+                            _length(      _suiteLength + 1 + strlen( testCase ) )
+                        {}
+                        
+                        size_t GetLength() const noexcept
+                        {
+                            return this->_length;
+                        }
+                        
+                        char operator []( size_t i ) const noexcept
+                        {
+                            if( i < this->_suiteLength )
+                            {
+                                return this->_suite[ i ];
+                            }
+                            
+                            return ( i == this->_suiteLength ) ? '.' : this->_case[ i - this->_suiteLength - 1 ];
+                        }
+                        
+                        std::string GetString() const
+                        {
+                            return std::string( this->_suite ) + "." + this->_case;
+                        }
+                        
+                    private:
+                        
+                        const char * _suite;
+                        const char * _case;
+                        size_t       _suiteLength;
+                        size_t       _length;
+                };
+                
+                /* Literal patterns and patterns ending with a single "*" are stored in a trie, other patterns are matched as globs */
+                class Patterns
+                {
+                    public:
+                        
+                        Patterns():
+                            _nodes( 1 )
+                        {}
+                        
+                        bool IsEmpty() const noexcept
+                        {
+                            return this->_nodes.size() == 1 && this->_nodes[ 0 ].terminal == false && this->_nodes[ 0 ].prefix == false && this->_globs.size() == 0;
+                        }
+                        
+                        void Add( const std::string & pattern )
+                        {
+                            size_t wildcard( pattern.find_first_of( "*?" ) );
+                            size_t node( 0 );
+                            
+                            if( wildcard != std::string::npos && wildcard != pattern.length() - 1 )
+                            {
+                                this->_globs.push_back( pattern );
+                                
+                                return;
+                            }
+                            
+                            if( wildcard != std::string::npos && pattern[ wildcard ] == '?' )
+                            {
+                                this->_globs.push_back( pattern );
+                                
+                                return;
+                            }
+                            
+                            for( size_t i = 0; i < std::min( wildcard, pattern.length() ); i++ )
+                            {
+                                size_t child( this->Child( node, pattern[ i ] ) );
+                                
+                                if( child == 0 )
+                                {
+                                    child = this->_nodes.size();
+                                    
+                                    this->_nodes.push_back( Node() );
+                                    this->_nodes[ node ].children.push_back( { pattern[ i ], child } );
+                                }
+                                
+                                node = child;
+                            }
+                            
+                            if( wildcard == std::string::npos )
+                            {
+                                this->_nodes[ node ].terminal = true;
+                            }
+                            else
+                            {
+                                this->_nodes[ node ].prefix = true;
+                            }
+                        }
+                        
+                        bool Matches( const Name & name ) const
+                        {
+                            size_t node( 0 );
+                            
+                            for( size_t i = 0; i < name.GetLength(); i++ )
+                            {
+                                if( this->_nodes[ node ].prefix )
+                                {
+                                    return true;
+                                }
+                                
+                                node = this->Child( node, name[ i ] );
+                                
+                                if( node == 0 )
+                                {
+                                    break;
+                                }
+                            }
+                            
+                            if( node != 0 && ( this->_nodes[ node ].terminal || this->_nodes[ node ].prefix ) )
+                            {
+                                return true;
+                            }
+                            
+                            for( const auto & glob: this->_globs )
+                            {
+                                if( Glob( glob, name ) )
+                                {
+                                    return true;
+                                }
+                            }
+                            
+                            return false;
+                        }
+                        
+                    private:
+                        
+                        class Node
+                        {
+                            public:
+                                
+                                std::vector< std::pair< char, size_t > > children;
+                                bool                                     terminal = false;
+                                bool                                     prefix   = false;
+                        };
+                        
+                        size_t Child( size_t node, char c ) const
+                        {
+                            for( const auto & p: this->_nodes[ node ].children )
+                            {
+                                if( p.first == c )
+                                {
+                                    return p.second;
+                                }
+                            }
+                            
+                            return 0;
+                        }
+                        
+                        static bool Glob( const std::string & pattern, const Name & name )
+                        {
+                            size_t p( 0 );
+                            size_t n( 0 );
+                            size_t star( std::string::npos );
+                            size_t mark( 0 );
+                            
+                            while( n < name.GetLength() )
+                            {
+                                if( p < pattern.length() && ( pattern[ p ] == '?' || pattern[ p ] == name[ n ] ) )
+                                {
+                                    p++;
+                                    n++;
+                                }
+                                else if( p < pattern.length() && pattern[ p ] == '*' )
+                                {
+                                    star = p++;
+                                    mark = n;
+                                }
+                                else if( star != std::string::npos )
+                                {
+                                    p = star + 1;
+                                    n = ++mark;
+                                }
+                                else
+                                {
+                                    return false;
+                                }
+                            }
+                            
+                            while( p < pattern.length() && pattern[ p ] == '*' )
+                            {
+                                p++;
+                            }
+                            
+                            return p == pattern.length();
+                        }
+                        
+                        std::vector< Node >        _nodes;
+                        std::vector< std::string > _globs;
+                };
+                
+                static void Split( const std::string & patterns, Patterns & list )
+                {
+                    size_t begin( 0 );
+                    
+                    while( begin <= patterns.length() )
+                    {
+                        size_t end( patterns.find( ':', begin ) );
+                        
+                        if( end == std::string::npos )
+                        {
+                            end = patterns.length();
+                        }
+                        
+                        if( end > begin )
+                        {
+                            list.Add( patterns.substr( begin, end - begin ) );
+                        }
+                        
+                        begin = end + 1;
+                    }
+                }
+                
+                Patterns                  _positive;
+                Patterns                  _negative;
+                std::vector< std::regex > _regexes;
+                bool                      _invalid;
+        };
+    }
+}
+
+#endif /* XS_TEST_FILTER_HPP */
@@ -44,7 +44,7 @@ namespace XS
     {
         inline int RunAll( const Arguments & args, Optional< std::reference_wrapper< std::ostream > > os = { std::cout } )
         {
-            Runner runner( Suite::All( args ) );
+            Runner runner( Suite::All( args ), args );
             
             return ( runner.Run( os ) ) ? 0 : -1;
         }
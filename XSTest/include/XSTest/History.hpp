@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      History.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_HISTORY_HPP
+#define XS_TEST_HISTORY_HPP
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
+#include <XSTest/Optional.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        class History
+        {
+            public:
+                
+                History()
+                {}
+                
+                History( const std::string & path ):
+                    _path( path )
+                {
+                    std::ifstream stream( path );
+                    std::string   line;
+                    
+                    while( std::getline( stream, line ) )
+                    {
+                        std::istringstream fields( line );
+                        int64_t            us( 0 );
+                        std::string        name;
+                        
+                        if( fields >> us >> name )
+                        {
+                            this->_durations[ name ] = std::chrono::microseconds( us );
+                        }
+                    }
+                }
+                
+                History( const History & o ):
+                    _path(      o._path ),
+                    _durations( o._durations )
+                {}
+                
+                History( History && o ) noexcept:
+                    _path(      std::move( o._path ) ),
+                    _durations( std::move( o._durations ) )
+                {}
+                
+                ~History()
+                {}
+                
+                History & operator =( History o )
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                std::string GetPath() const
+                {
+                    return this->_path;
+                }
+                
+                bool IsEmpty() const
+                {
+                    return this->_durations.size() == 0;
+                }
+                
+                Optional< std::chrono::microseconds > GetDuration( const std::string & name ) const
+                {
+                    auto it( this->_durations.find( name ) );
+                    
+                    if( it == this->_durations.end() )
+                    {
+                        return {};
+                    }
+                    
+                    return it->second;
+                }
+                
+                void SetDuration( const std::string & name, std::chrono::microseconds duration )
+                {
+                    this->_durations[ name ] = duration;
+                }
+                
+                bool Save() const
+                {
+                    std::ofstream stream;
+                    
+                    if( this->_path.length() == 0 )
+                    {
+                        return false;
+                    }
+                    
+                    stream.open( this->_path, std::ios::out | std::ios::trunc );
+                    
+                    for( const auto & p: this->_durations )
+                    {
+                        stream << p.second.count() << " " << p.first << "\n";
+                    }
+                    
+                    return stream.good();
+                }
+                
+                friend void swap( History & o1, History & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._path,      o2._path );
+                    swap( o1._durations, o2._durations );
+                }
+                
+            private:
+                
+                std::string                                                   _path;
+                std::unordered_map< std::string, std::chrono::microseconds > _durations;
+        };
+    }
+}
+
+#endif /* XS_TEST_HISTORY_HPP */
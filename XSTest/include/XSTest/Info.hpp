@@ -34,45 +34,32 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <functional>
 #include <algorithm>
-#include <random>
-#include <map>
+#include <chrono>
 #include <XSTest/Optional.hpp>
 #include <XSTest/Failure.hpp>
+#include <XSTest/Collector.hpp>
 #include <XSTest/Case.hpp>
+#include <XSTest/SuiteFixtures.hpp>
+#include <XSTest/Registration.hpp>
 #include <XSTest/StopWatch.hpp>
+#include <XSTest/Benchmark.hpp>
+#include <XSTest/Allocations.hpp>
+#include <XSTest/ResourceUsage.hpp>
+#include <XSTest/Repetition.hpp>
 #include <XSTest/Logging.hpp>
 #include <XSTest/TermColor.hpp>
 
-#define XS_TEST_GET_ALL_INFOS_DECLARATION                                   \
-    std::vector< std::shared_ptr< Info > > & GetAllInfos();
-
-#define XS_TEST_GET_ALL_INFOS_DEFINITION                                    \
-    std::vector< std::shared_ptr< Info > > & GetAllInfos()                  \
-    {                                                                       \
-        static auto infos = new std::vector< std::shared_ptr< Info > >();   \
-                                                                            \
-        return *( infos );                                                  \
-    }
-
 namespace XS
 {
     namespace Test
     {
         class Suite;
         class Case;
+        class Isolation;
+        class Watchdog;
+        class Runner;
         
-        #if defined( XSTEST_MAIN ) || defined( XSTEST_MAIN_RUN )
-        
-        inline XS_TEST_GET_ALL_INFOS_DEFINITION
-        
-        #else
-        
-        extern XS_TEST_GET_ALL_INFOS_DECLARATION
-        
-        #endif
-
         class Info
         {
             public:
@@ -82,48 +69,69 @@ namespace XS
                     Unknown,
                     Running,
                     Success,
-                    Failed
+                    Failed,
+                    TimedOut
                 };
                 
-                static Info & Register( const std::string & testCaseName, const std::string & testName, const std::function< std::shared_ptr< Case >() > createTest, const std::string & file, size_t line )
-                {
-                    Info * i = new Info( testCaseName, testName, createTest, file, line );
-                                        
-                    GetInfos().push_back( std::shared_ptr< Info >( i ) );
-                    
-                    return *( i );
-                }
-                
                 static std::vector< Info > All()
                 {
                     std::vector< Info > all;
                     
-                    for( auto & i: GetInfos() )
+                    all.reserve( GetRegistry().GetCount() );
+                    
+                    for( const Registration * r = GetRegistry().GetFirst(); r != nullptr; r = r->GetNext() )
                     {
-                        all.push_back( *( i ) );
+                        if( r->IsParameterized() == false )
+                        {
+                            all.push_back( Info( *( r ) ) );
+                        }
+                        
+                        for( size_t i = 0; i < r->GetParameterCount(); i++ )
+                        {
+                            all.push_back( Info( *( r ), i ) );
+                        }
                     }
                     
                     return all;
                 }
                 
+                explicit Info( const Registration & registration, size_t parameter = 0 ):
+                    _registration( &registration ),
+                    _parameter( parameter ),
+                    _status( Status::Unknown ),
+                    _duration( 0 ),
+                    _threadCPUTime( 0 ),
+                    _processCPUTime( 0 )
+                {}
+                
                 Info( const Info & o ):
-                    _suiteName(  o._suiteName ),
-                    _caseName(   o._caseName ),
-                    _createTest( o._createTest ),
-                    _status(     o._status ),
-                    _file(       o._file ),
-                    _line(       o._line ),
-                    _failure(    o._failure )
+                    _registration(   o._registration ),
+                    _parameter(      o._parameter ),
+                    _status(         o._status ),
+                    _failure(        o._failure ),
+                    _failures(       o._failures ),
+                    _duration(       o._duration ),
+                    _threadCPUTime(  o._threadCPUTime ),
+                    _processCPUTime( o._processCPUTime ),
+                    _benchmark(      o._benchmark ),
+                    _allocations(    o._allocations ),
+                    _resourceUsage(  o._resourceUsage ),
+                    _repetition(     o._repetition )
                 {}
                 
                 Info( Info && o ) noexcept:
-                    _suiteName(  std::move( o._suiteName ) ),
-                    _caseName(   std::move( o._caseName ) ),
-                    _createTest( std::move( o._createTest ) ),
-                    _status(     std::move( o._status ) ),
-                    _file(       std::move( o._file ) ),
-                    _line(       std::move( o._line ) ),
-                    _failure(    std::move( o._failure ) )
+                    _registration(   std::move( o._registration ) ),
+                    _parameter(      std::move( o._parameter ) ),
+                    _status(         std::move( o._status ) ),
+                    _failure(        std::move( o._failure ) ),
+                    _failures(       std::move( o._failures ) ),
+                    _duration(       std::move( o._duration ) ),
+                    _threadCPUTime(  std::move( o._threadCPUTime ) ),
+                    _processCPUTime( std::move( o._processCPUTime ) ),
+                    _benchmark(      std::move( o._benchmark ) ),
+                    _allocations(    std::move( o._allocations ) ),
+                    _resourceUsage(  std::move( o._resourceUsage ) ),
+                    _repetition(     std::move( o._repetition ) )
                 {}
                 
                 ~Info()
@@ -136,19 +144,60 @@ namespace XS
                     return *( this );
                 }
                 
+                const Registration & GetRegistration() const noexcept
+                {
+                    return *( this->_registration );
+                }
+                
                 std::string GetName() const
                 {
-                    return this->_suiteName + "." + this->_caseName;
+                    std::string name;
+                    
+                    this->GetName( name );
+                    
+                    return name;
+                }
+                
+                /* Reusing the same string avoids allocating a name for each test case, when looking up a lot of them */
+                void GetName( std::string & name ) const
+                {
+                    name.assign( this->_registration->GetSuiteName() ).append( "." ).append( this->_registration->GetCaseName() );
+                    
+                    if( this->_registration->IsParameterized() )
+                    {
+                        name.append( "/" ).append( std::to_string( this->_parameter ) );
+                    }
                 }
                 
                 std::string GetSuiteName() const
                 {
-                    return this->_suiteName;
+                    return this->_registration->GetSuiteName();
                 }
                 
                 std::string GetCaseName() const
                 {
-                    return this->_caseName;
+                    /* Names of parameterized test cases are only generated when needed, as there may be a lot of them */
+                    if( this->_registration->IsParameterized() )
+                    {
+                        return std::string( this->_registration->GetCaseName() ) + "/" + std::to_string( this->_parameter );
+                    }
+                    
+                    return this->_registration->GetCaseName();
+                }
+                
+                std::string GetDisplayCaseName() const
+                {
+                    if( this->_registration->GetTypeName() != nullptr )
+                    {
+                        return this->GetCaseName() + " (TypeParam = " + this->_registration->GetTypeName() + ")";
+                    }
+                    
+                    return this->GetCaseName();
+                }
+                
+                size_t GetParameterIndex() const noexcept
+                {
+                    return this->_parameter;
                 }
                 
                 Status GetStatus() const noexcept
@@ -158,12 +207,12 @@ namespace XS
                 
                 std::string GetFile() const
                 {
-                    return this->_file;
+                    return this->_registration->GetFile();
                 }
                 
                 size_t GetLine() const noexcept
                 {
-                    return this->_line;
+                    return this->_registration->GetLine();
                 }
                 
                 Optional< Failure > GetFailure() const
@@ -171,43 +220,119 @@ namespace XS
                     return this->_failure;
                 }
                 
+                const std::vector< Failure > & GetFailures() const
+                {
+                    return this->_failures;
+                }
+                
+                std::chrono::nanoseconds GetDuration() const noexcept
+                {
+                    return this->_duration;
+                }
+                
+                std::chrono::nanoseconds GetThreadCPUTime() const noexcept
+                {
+                    return this->_threadCPUTime;
+                }
+                
+                std::chrono::nanoseconds GetProcessCPUTime() const noexcept
+                {
+                    return this->_processCPUTime;
+                }
+                
+                Optional< Benchmark > GetBenchmark() const
+                {
+                    return this->_benchmark;
+                }
+                
+                Optional< Allocations > GetAllocations() const
+                {
+                    return this->_allocations;
+                }
+                
+                Optional< ResourceUsage > GetResourceUsage() const
+                {
+                    return this->_resourceUsage;
+                }
+                
+                Optional< Repetition > GetRepetition() const
+                {
+                    return this->_repetition;
+                }
+                
                 bool Run( Optional< std::reference_wrapper< std::ostream > > os )
                 {
                     StopWatch               time;
-                    std::shared_ptr< Case > test( this->_createTest() );
+                    Allocations::Counters   allocations;
+                    ResourceUsage           usage;
+                    Optional< Failure >     suite( SuiteFixtures::SetUp( *( this->_registration ) ) );
+                    std::unique_ptr< Case > test( this->_registration->Create() );
+                    Collector               collector;
+                    Collector::Scope        scope( collector );
+                    Collector::Running      running( collector );
+                    
+                    test->_info = this;
                     
                     this->_failure.Reset();
+                    this->_failures.clear();
+                    this->_benchmark.Reset();
+                    this->_allocations.Reset();
+                    this->_resourceUsage.Reset();
                     
                     this->_status = Status::Running;
                     
-                    test->SetUp();
+                    if( suite.HasValue() )
+                    {
+                        collector.Add( suite.Value() );
+                    }
+                    
+                    /* The test body is skipped if the fixture can't be set up, but the fixture is still torn down */
+                    bool ready( suite.HasValue() == false && this->Call( collector, [ & ] { test->SetUp(); } ) );
+                    
+                    allocations = Allocations::Begin();
+                    usage       = ResourceUsage::Current();
+                    
                     time.Start();
                     
-                    try
+                    if( ready )
                     {
-                        test->Test();
-                        
-                        this->_status = Status::Success;
+                        this->Call( collector, [ & ] { test->Test(); } );
                     }
-                    catch( const Failure & e )
+                    
+                    time.Stop();
+                    
+                    this->_resourceUsage = ResourceUsage::Current() - usage;
+                    
+                    if( Allocations::IsTracking() )
                     {
-                        this->_failure = e;
-                        this->_status  = Status::Failed;
+                        this->_allocations = Allocations::End( allocations );
                     }
-                    catch( const std::exception & e )
+                    
+                    if( suite.HasValue() == false )
                     {
-                        this->_failure = Failure( std::string( "Caught unexpected exception: " ) + e.what(), this->_file, this->_line );
-                        this->_status  = Status::Failed;
+                        this->Call( collector, [ & ] { test->TearDown(); } );
                     }
-                    catch( ... )
+                    
+                    /* Failures are collected in order, so a fatal one comes after the non-fatal ones that preceded it */
+                    this->_failures = collector.GetFailures();
+                    this->_status   = ( this->_failures.size() > 0 ) ? Status::Failed : Status::Success;
+                    
+                    if( this->_failures.size() > 0 )
                     {
-                        this->_failure = Failure( "Caught unexpected exception", this->_file, this->_line );
-                        this->_status  = Status::Failed;
+                        this->_failure = this->_failures.front();
                     }
                     
-                    time.Stop();
-                    test->TearDown();
-                    Logging::Log( os, this->_suiteName, this->_caseName, this->_failure, time );
+                    this->_duration       = time.GetDuration();
+                    this->_threadCPUTime  = time.GetThreadCPUTime();
+                    this->_processCPUTime = time.GetProcessCPUTime();
+                    this->_benchmark      = test->_benchmark;
+                    
+                    Logging::Log( os, this->GetSuiteName(), this->GetDisplayCaseName(), this->_failures, time, this->_allocations, this->_resourceUsage );
+                    
+                    if( this->_benchmark.HasValue() && this->_status == Status::Success )
+                    {
+                        Logging::Log( os, this->_benchmark.Value() );
+                    }
                     
                     return this->_status == Status::Success;
                 }
@@ -216,38 +341,63 @@ namespace XS
                 {
                     using std::swap;
                     
-                    swap( o1._suiteName,  o2._suiteName );
-                    swap( o1._caseName,   o2._caseName );
-                    swap( o1._createTest, o2._createTest );
-                    swap( o1._status,     o2._status );
-                    swap( o1._file,       o2._file );
-                    swap( o1._line,       o2._line );
-                    swap( o1._failure,    o2._failure );
+                    swap( o1._registration,   o2._registration );
+                    swap( o1._parameter,      o2._parameter );
+                    swap( o1._status,         o2._status );
+                    swap( o1._failure,        o2._failure );
+                    swap( o1._failures,       o2._failures );
+                    swap( o1._duration,       o2._duration );
+                    swap( o1._threadCPUTime,  o2._threadCPUTime );
+                    swap( o1._processCPUTime, o2._processCPUTime );
+                    swap( o1._benchmark,      o2._benchmark );
+                    swap( o1._allocations,    o2._allocations );
+                    swap( o1._resourceUsage,  o2._resourceUsage );
+                    swap( o1._repetition,     o2._repetition );
                 }
                 
             private:
                 
-                static std::vector< std::shared_ptr< Info > > & GetInfos()
+                friend class Isolation;
+                friend class Watchdog;
+                friend class Runner;
+                
+                template< typename _F_ >
+                bool Call( Collector & collector, _F_ f ) const
                 {
-                    return GetAllInfos();
+                    try
+                    {
+                        f();
+                        
+                        return true;
+                    }
+                    catch( const Failure & e )
+                    {
+                        collector.Add( e );
+                    }
+                    catch( const std::exception & e )
+                    {
+                        collector.Add( Failure( std::string( "Caught unexpected exception: " ) + e.what(), this->GetFile(), this->GetLine() ) );
+                    }
+                    catch( ... )
+                    {
+                        collector.Add( Failure( "Caught unexpected exception", this->GetFile(), this->GetLine() ) );
+                    }
+                    
+                    return false;
                 }
                 
-                Info( const std::string & suiteName, const std::string & caseName, const std::function< std::shared_ptr< Case >() > createTest, const std::string & file, size_t line ):
-                    _suiteName( suiteName ),
-                    _caseName( caseName ),
-                    _createTest( createTest ),
-                    _status( Status::Unknown ),
-                    _file( file ),
-                    _line( line )
-                {}
-                
-                std::string                                _suiteName;
-                std::string                                _caseName;
-                std::function< std::shared_ptr< Case >() > _createTest;
-                Status                                     _status;
-                std::string                                _file;
-                size_t                                     _line;
-                Optional< Failure >                        _failure;
+                const Registration *      _registration;
+                size_t                    _parameter;
+                Status                    _status;
+                Optional< Failure >       _failure;
+                std::vector< Failure >    _failures;
+                std::chrono::nanoseconds  _duration;
+                std::chrono::nanoseconds  _threadCPUTime;
+                std::chrono::nanoseconds  _processCPUTime;
+                Optional< Benchmark >     _benchmark;
+                Optional< Allocations >   _allocations;
+                Optional< ResourceUsage > _resourceUsage;
+                Optional< Repetition >    _repetition;
         };
     }
 }
@@ -0,0 +1,990 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Isolation.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_ISOLATION_HPP
+#define XS_TEST_ISOLATION_HPP
+
+#ifndef _WIN32
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <sstream>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <stdexcept>
+#include <algorithm>
+#include <csignal>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <XSTest/Optional.hpp>
+#include <XSTest/Info.hpp>
+#include <XSTest/SuiteFixtures.hpp>
+#include <XSTest/Environment.hpp>
+#include <XSTest/Failure.hpp>
+#include <XSTest/Benchmark.hpp>
+#include <XSTest/Statistics.hpp>
+#include <XSTest/Allocations.hpp>
+#include <XSTest/ResourceUsage.hpp>
+#include <XSTest/StopWatch.hpp>
+#include <XSTest/Watchdog.hpp>
+#include <XSTest/Logging.hpp>
+#include <XSTest/TermColor.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Isolation
+        {
+            public:
+                
+                /* Workers are forked from a zygote process, forked here, so this must be created before the runner starts any thread */
+                Isolation( size_t workers, Optional< std::reference_wrapper< std::ostream > > os, std::mutex & output, Watchdog & watchdog ):
+                    _os(       os ),
+                    _output(   output ),
+                    _watchdog( watchdog ),
+                    _zygote(   0 ),
+                    _socket(   -1 )
+                {
+                    int sockets[ 2 ];
+                    
+                    signal( SIGPIPE, SIG_IGN );
+                    
+                    if( socketpair( AF_UNIX, SOCK_STREAM, 0, sockets ) != 0 )
+                    {
+                        throw std::runtime_error( "Cannot create a socket for the isolated workers" );
+                    }
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_output );
+                        
+                        Logging::Flush( this->_os );
+                        
+                        this->_zygote = fork();
+                    }
+                    
+                    if( this->_zygote < 0 )
+                    {
+                        close( sockets[ 0 ] );
+                        close( sockets[ 1 ] );
+                        
+                        throw std::runtime_error( "Cannot fork the isolated workers" );
+                    }
+                    
+                    if( this->_zygote == 0 )
+                    {
+                        close( sockets[ 0 ] );
+                        this->Zygote( sockets[ 1 ] );
+                        _exit( 0 );
+                    }
+                    
+                    close( sockets[ 1 ] );
+                    
+                    this->_socket = sockets[ 0 ];
+                    
+                    for( size_t i = 0; i < std::max< size_t >( workers, 1 ); i++ )
+                    {
+                        this->_workers.push_back( this->Spawn() );
+                        this->_idle.push_back( i );
+                    }
+                }
+                
+                Isolation( const Isolation & o )              = delete;
+                Isolation & operator =( const Isolation & o ) = delete;
+                
+                ~Isolation()
+                {
+                    this->TearDown();
+                }
+                
+                bool Run( Info & info, Optional< std::reference_wrapper< std::ostream > > os )
+                {
+                    size_t                  index;
+                    Worker                  worker;
+                    StopWatch               time;
+                    uint64_t                watch;
+                    bool                    received( false );
+                    Optional< std::string > expired;
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        
+                        index = this->_idle.back();
+                        
+                        this->_idle.pop_back();
+                        
+                        worker = this->_workers[ index ];
+                    }
+                    
+                    info._failure.Reset();
+                    info._failures.clear();
+                    info._allocations.Reset();
+                    info._resourceUsage.Reset();
+                    
+                    info._status = Info::Status::Running;
+                    
+                    time.Start();
+                    
+                    watch = this->_watchdog.Watch( info, [ worker ] { Watchdog::Kill( worker.pid ); } );
+                    
+                    /* Workers are forked from a copy of this process, so the address of the Info is also valid in the worker */
+                    if( Write( worker.input, reinterpret_cast< uint64_t >( &info ) ) )
+                    {
+                        received = Receive( worker.output, info, os );
+                    }
+                    
+                    expired = this->_watchdog.Unwatch( watch );
+                    
+                    time.Stop();
+                    
+                    if( expired.HasValue() )
+                    {
+                        this->Wait( worker.pid );
+                        Watchdog::Expire( info, time.GetDuration(), expired.Value() );
+                        
+                        Logging::Log( os, info.GetSuiteName(), info.GetDisplayCaseName(), info._failure, time );
+                    }
+                    else if( received == false )
+                    {
+                        info._failure        = Failure( Describe( this->Wait( worker.pid ) ), info.GetFile(), info.GetLine() );
+                        info._failures       = std::vector< Failure >( 1, info._failure.Value() );
+                        info._status         = Info::Status::Failed;
+                        info._duration       = time.GetDuration();
+                        info._threadCPUTime  = std::chrono::nanoseconds( 0 );
+                        info._processCPUTime = std::chrono::nanoseconds( 0 );
+                        
+                        Logging::Log( os, info.GetSuiteName(), info.GetDisplayCaseName(), info._failure, time );
+                    }
+                    
+                    if( received == false || expired.HasValue() )
+                    {
+                        {
+                            std::lock_guard< std::mutex > l( this->_mutex );
+                            
+                            /* The dead worker is forgotten before its descriptors are closed, as a new pipe may reuse their numbers */
+                            this->_workers[ index ].input  = -1;
+                            this->_workers[ index ].output = -1;
+                            
+                            close( worker.input );
+                            close( worker.output );
+                        }
+                        
+                        worker = this->Spawn();
+                    }
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        
+                        this->_workers[ index ] = worker;
+                        
+                        this->_idle.push_back( index );
+                    }
+                    
+                    return info._status == Info::Status::Success;
+                }
+                
+                /* Closing the input of the workers lets them tear down their test suites, and report failures before exiting */
+                bool TearDown()
+                {
+                    bool success( true );
+                    
+                    for( const auto & worker: this->_workers )
+                    {
+                        close( worker.input );
+                    }
+                    
+                    for( const auto & worker: this->_workers )
+                    {
+                        std::vector< std::pair< std::string, Failure > > failures;
+                        
+                        if( Read( worker.output, failures ) )
+                        {
+                            std::lock_guard< std::mutex > l( this->_output );
+                            
+                            for( const auto & p: failures )
+                            {
+                                Logging::Log( this->_os, p.first + ": " + p.second.GetDescription(), {}, Logging::Style::Failure );
+                                
+                                success = false;
+                            }
+                        }
+                        
+                        close( worker.output );
+                    }
+                    
+                    this->_workers.clear();
+                    this->_idle.clear();
+                    
+                    /* The zygote reaps the remaining workers once its socket is closed */
+                    if( this->_socket >= 0 )
+                    {
+                        close( this->_socket );
+                        waitpid( this->_zygote, nullptr, 0 );
+                        
+                        this->_socket = -1;
+                    }
+                    
+                    return success;
+                }
+                
+            private:
+                
+                enum class Request: uint64_t
+                {
+                    Spawn,
+                    Wait
+                };
+                
+                class Worker
+                {
+                    public:
+                        
+                        pid_t pid    = 0;
+                        int   input  = -1;
+                        int   output = -1;
+                };
+                
+                Worker Spawn()
+                {
+                    std::lock_guard< std::mutex > l( this->_requests );
+                    Worker                        worker;
+                    
+                    if( Write( this->_socket, static_cast< uint64_t >( Request::Spawn ) ) == false || ReceiveWorker( this->_socket, worker ) == false )
+                    {
+                        throw std::runtime_error( "Cannot fork an isolated worker" );
+                    }
+                    
+                    return worker;
+                }
+                
+                /* Workers are children of the zygote, which reaps them and reports how they ended */
+                Optional< int > Wait( pid_t pid )
+                {
+                    std::lock_guard< std::mutex > l( this->_requests );
+                    uint64_t                      reaped;
+                    uint64_t                      status;
+                    
+                    if
+                    (
+                           Write( this->_socket, static_cast< uint64_t >( Request::Wait ) ) == false
+                        || Write( this->_socket, static_cast< uint64_t >( pid ) ) == false
+                        || Read( this->_socket, reaped ) == false
+                        || Read( this->_socket, status ) == false
+                        || reaped == 0
+                    )
+                    {
+                        return {};
+                    }
+                    
+                    return static_cast< int >( status );
+                }
+                
+                static std::string Describe( Optional< int > status )
+                {
+                    if( status.HasValue() == false )
+                    {
+                        return "Isolated worker process was lost";
+                    }
+                    
+                    if( WIFSIGNALED( status.Value() ) )
+                    {
+                        return "Crashed with signal " + std::to_string( WTERMSIG( status.Value() ) ) + " (" + strsignal( WTERMSIG( status.Value() ) ) + ")";
+                    }
+                    
+                    if( WIFEXITED( status.Value() ) )
+                    {
+                        return "Exited with status " + std::to_string( WEXITSTATUS( status.Value() ) );
+                    }
+                    
+                    return "Isolated worker process terminated unexpectedly";
+                }
+                
+                /* The zygote is single-threaded, so workers are never forked while another thread holds a lock */
+                void Zygote( int socket )
+                {
+                    uint64_t request;
+                    
+                    while( Read( socket, request ) )
+                    {
+                        if( request == static_cast< uint64_t >( Request::Spawn ) )
+                        {
+                            this->Fork( socket );
+                        }
+                        else if( request == static_cast< uint64_t >( Request::Wait ) )
+                        {
+                            uint64_t pid;
+                            int      status( 0 );
+                            bool     reaped;
+                            
+                            if( Read( socket, pid ) == false )
+                            {
+                                break;
+                            }
+                            
+                            reaped = waitpid( static_cast< pid_t >( pid ), &status, 0 ) == static_cast< pid_t >( pid );
+                            
+                            if( Write( socket, static_cast< uint64_t >( reaped ) ) == false || Write( socket, static_cast< uint64_t >( status ) ) == false )
+                            {
+                                break;
+                            }
+                        }
+                    }
+                    
+                    close( socket );
+                    
+                    while( wait( nullptr ) > 0 )
+                    {}
+                }
+                
+                void Fork( int socket )
+                {
+                    int    input[ 2 ];
+                    int    output[ 2 ];
+                    Worker worker;
+                    
+                    if( pipe( input ) != 0 )
+                    {
+                        SendWorker( socket, worker );
+                        
+                        return;
+                    }
+                    
+                    if( pipe( output ) != 0 )
+                    {
+                        close( input[ 0 ] );
+                        close( input[ 1 ] );
+                        SendWorker( socket, worker );
+                        
+                        return;
+                    }
+                    
+                    worker.pid = fork();
+                    
+                    if( worker.pid == 0 )
+                    {
+                        close( socket );
+                        close( input[ 1 ] );
+                        close( output[ 0 ] );
+                        this->Work( input[ 0 ], output[ 1 ] );
+                        Write( output[ 1 ], SuiteFixtures::TearDownAll() );
+                        Environment::TearDown();
+                        _exit( 0 );
+                    }
+                    
+                    close( input[ 0 ] );
+                    close( output[ 1 ] );
+                    
+                    if( worker.pid > 0 )
+                    {
+                        worker.input  = input[ 1 ];
+                        worker.output = output[ 0 ];
+                    }
+                    else
+                    {
+                        worker.pid = 0;
+                    }
+                    
+                    SendWorker( socket, worker );
+                    close( input[ 1 ] );
+                    close( output[ 0 ] );
+                }
+                
+                /* The pipes of a worker are passed to the runner over the zygote socket */
+                static bool SendWorker( int socket, const Worker & worker )
+                {
+                    uint64_t      pid( static_cast< uint64_t >( worker.pid ) );
+                    int           fds[ 2 ] = { worker.input, worker.output };
+                    struct iovec  vector;
+                    struct msghdr message;
+                    
+                    union
+                    {
+                        struct cmsghdr header;
+                        char           buffer[ CMSG_SPACE( sizeof( fds ) ) ];
+                    }
+                    control;
+                    
+                    memset( &message, 0, sizeof( message ) );
+                    memset( &control, 0, sizeof( control ) );
+                    
+                    vector.iov_base    = &pid;
+                    vector.iov_len     = sizeof( pid );
+                    message.msg_iov    = &vector;
+                    message.msg_iovlen = 1;
+                    
+                    if( worker.pid > 0 )
+                    {
+                        message.msg_control    = control.buffer;
+                        message.msg_controllen = sizeof( control.buffer );
+                        
+                        CMSG_FIRSTHDR( &message )->cmsg_level = SOL_SOCKET;
+                        CMSG_FIRSTHDR( &message )->cmsg_type  = SCM_RIGHTS;
+                        CMSG_FIRSTHDR( &message )->cmsg_len   = CMSG_LEN( sizeof( fds ) );
+                        
+                        memcpy( CMSG_DATA( CMSG_FIRSTHDR( &message ) ), fds, sizeof( fds ) );
+                    }
+                    
+                    while( true )
+                    {
+                        ssize_t n( sendmsg( socket, &message, 0 ) );
+                        
+                        if( n < 0 && errno == EINTR )
+                        {
+                            continue;
+                        }
+                        
+                        return n == static_cast< ssize_t >( sizeof( pid ) );
+                    }
+                }
+                
+                static bool ReceiveWorker( int socket, Worker & worker )
+                {
+                    uint64_t         pid( 0 );
+                    struct iovec     vector;
+                    struct msghdr    message;
+                    struct cmsghdr * header;
+                    ssize_t          n;
+                    
+                    union
+                    {
+                        struct cmsghdr header;
+                        char           buffer[ CMSG_SPACE( sizeof( int ) * 2 ) ];
+                    }
+                    control;
+                    
+                    memset( &message, 0, sizeof( message ) );
+                    memset( &control, 0, sizeof( control ) );
+                    
+                    vector.iov_base        = &pid;
+                    vector.iov_len         = sizeof( pid );
+                    message.msg_iov        = &vector;
+                    message.msg_iovlen     = 1;
+                    message.msg_control    = control.buffer;
+                    message.msg_controllen = sizeof( control.buffer );
+                    
+                    do
+                    {
+                        n = recvmsg( socket, &message, 0 );
+                    }
+                    while( n < 0 && errno == EINTR );
+                    
+                    header = CMSG_FIRSTHDR( &message );
+                    
+                    if( n != static_cast< ssize_t >( sizeof( pid ) ) || pid == 0 || header == nullptr || header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS )
+                    {
+                        return false;
+                    }
+                    
+                    worker.pid = static_cast< pid_t >( pid );
+                    
+                    memcpy( &( worker.input ),  CMSG_DATA( header ),                 sizeof( int ) );
+                    memcpy( &( worker.output ), CMSG_DATA( header ) + sizeof( int ), sizeof( int ) );
+                    
+                    return true;
+                }
+                
+                void Work( int input, int output )
+                {
+                    uint64_t address;
+                    
+                    while( Read( input, address ) )
+                    {
+                        Info             & info( *( reinterpret_cast< Info * >( address ) ) );
+                        std::ostringstream buffer;
+                        bool               success;
+                        
+                        if( this->_os.HasValue() )
+                        {
+                            TermColor::Mirror( buffer, this->_os->get() );
+                            
+                            success = info.Run( std::reference_wrapper< std::ostream >( buffer ) );
+                        }
+                        else
+                        {
+                            success = info.Run( {} );
+                        }
+                        
+                        std::cout.flush();
+                        std::cerr.flush();
+                        
+                        if
+                        (
+                               Write( output, static_cast< uint64_t >( success ) ) == false
+                            || Write( output, static_cast< uint64_t >( info._duration.count() ) ) == false
+                            || Write( output, static_cast< uint64_t >( info._threadCPUTime.count() ) ) == false
+                            || Write( output, static_cast< uint64_t >( info._processCPUTime.count() ) ) == false
+                            || Write( output, info._failures ) == false
+                            || Write( output, static_cast< uint64_t >( info._benchmark.HasValue() ) ) == false
+                            || ( info._benchmark.HasValue() && Write( output, info._benchmark.Value() ) == false )
+                            || Write( output, static_cast< uint64_t >( info._allocations.HasValue() ) ) == false
+                            || ( info._allocations.HasValue() && Write( output, info._allocations.Value() ) == false )
+                            || Write( output, static_cast< uint64_t >( info._resourceUsage.HasValue() ) ) == false
+                            || ( info._resourceUsage.HasValue() && Write( output, info._resourceUsage.Value() ) == false )
+                            || Write( output, buffer.str() ) == false
+                        )
+                        {
+                            break;
+                        }
+                    }
+                }
+                
+                static bool Receive( int fd, Info & info, Optional< std::reference_wrapper< std::ostream > > os )
+                {
+                    uint64_t               success;
+                    uint64_t               duration;
+                    uint64_t               threadCPUTime;
+                    uint64_t               processCPUTime;
+                    uint64_t               measured;
+                    std::vector< Failure > failures;
+                    Optional< Benchmark >  benchmark;
+                    uint64_t               tracked;
+                    Allocations            allocations;
+                    uint64_t               used;
+                    ResourceUsage          usage;
+                    std::string            output;
+                    
+                    if
+                    (
+                           Read( fd, success ) == false
+                        || Read( fd, duration ) == false
+                        || Read( fd, threadCPUTime ) == false
+                        || Read( fd, processCPUTime ) == false
+                        || Read( fd, failures ) == false
+                    )
+                    {
+                        return false;
+                    }
+                    
+                    if( Read( fd, measured ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    if( measured != 0 && Read( fd, benchmark ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    if( Read( fd, tracked ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    if( tracked != 0 && Read( fd, allocations ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    if( Read( fd, used ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    if( used != 0 && Read( fd, usage ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    if( Read( fd, output ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    info._status         = ( success != 0 ) ? Info::Status::Success : Info::Status::Failed;
+                    info._duration       = std::chrono::nanoseconds( static_cast< int64_t >( duration ) );
+                    info._threadCPUTime  = std::chrono::nanoseconds( static_cast< int64_t >( threadCPUTime ) );
+                    info._processCPUTime = std::chrono::nanoseconds( static_cast< int64_t >( processCPUTime ) );
+                    
+                    if( failures.size() > 0 )
+                    {
+                        info._failure  = failures.front();
+                        info._failures = std::move( failures );
+                    }
+                    
+                    info._benchmark = benchmark;
+                    
+                    if( tracked != 0 )
+                    {
+                        info._allocations = allocations;
+                    }
+                    
+                    if( used != 0 )
+                    {
+                        info._resourceUsage = usage;
+                    }
+                    
+                    if( os.HasValue() )
+                    {
+                        os->get() << output;
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Write( int fd, const void * data, size_t size )
+                {
+                    const char * bytes( static_cast< const char * >( data ) );
+                    
+                    while( size > 0 )
+                    {
+                        ssize_t n( write( fd, bytes, size ) );
+                        
+                        if( n < 0 && errno == EINTR )
+                        {
+                            continue;
+                        }
+                        
+                        if( n <= 0 )
+                        {
+                            return false;
+                        }
+                        
+                        bytes += n;
+                        size  -= static_cast< size_t >( n );
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Write( int fd, uint64_t value )
+                {
+                    return Write( fd, &value, sizeof( value ) );
+                }
+                
+                static bool Write( int fd, const std::string & value )
+                {
+                    return Write( fd, static_cast< uint64_t >( value.length() ) ) && Write( fd, value.data(), value.length() );
+                }
+                
+                static bool Write( int fd, const Failure & failure )
+                {
+                    return Write( fd, failure.GetExpression() )
+                        && Write( fd, failure.GetEvaluated() )
+                        && Write( fd, failure.GetExpected() )
+                        && Write( fd, failure.GetActual() )
+                        && Write( fd, failure.GetFile() )
+                        && Write( fd, failure.GetDescription() )
+                        && Write( fd, static_cast< uint64_t >( failure.GetLine() ) );
+                }
+                
+                static bool Write( int fd, const std::vector< Failure > & failures )
+                {
+                    if( Write( fd, static_cast< uint64_t >( failures.size() ) ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    for( const auto & failure: failures )
+                    {
+                        if( Write( fd, failure ) == false )
+                        {
+                            return false;
+                        }
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Write( int fd, const std::vector< std::pair< const char *, Failure > > & failures )
+                {
+                    if( Write( fd, static_cast< uint64_t >( failures.size() ) ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    for( const auto & p: failures )
+                    {
+                        if( Write( fd, std::string( p.first ) ) == false || Write( fd, p.second ) == false )
+                        {
+                            return false;
+                        }
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Write( int fd, const Benchmark & benchmark )
+                {
+                    if( Write( fd, static_cast< uint64_t >( benchmark.GetIterations() ) ) == false || Write( fd, static_cast< uint64_t >( benchmark.GetStatistics().GetCount() ) ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    for( double sample: benchmark.GetStatistics().GetSamples() )
+                    {
+                        if( Write( fd, &sample, sizeof( sample ) ) == false )
+                        {
+                            return false;
+                        }
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Write( int fd, const Allocations & allocations )
+                {
+                    return Write( fd, allocations.GetCount() )
+                        && Write( fd, allocations.GetBytes() )
+                        && Write( fd, allocations.GetPeak() );
+                }
+                
+                static bool Write( int fd, const ResourceUsage & usage )
+                {
+                    return Write( fd, static_cast< uint64_t >( usage.GetUserTime().count() ) )
+                        && Write( fd, static_cast< uint64_t >( usage.GetSystemTime().count() ) )
+                        && Write( fd, usage.GetMaxRSS() )
+                        && Write( fd, usage.GetMinorFaults() )
+                        && Write( fd, usage.GetMajorFaults() )
+                        && Write( fd, usage.GetVoluntarySwitches() )
+                        && Write( fd, usage.GetInvoluntarySwitches() );
+                }
+                
+                static bool Read( int fd, void * data, size_t size )
+                {
+                    char * bytes( static_cast< char * >( data ) );
+                    
+                    while( size > 0 )
+                    {
+                        ssize_t n( read( fd, bytes, size ) );
+                        
+                        if( n < 0 && errno == EINTR )
+                        {
+                            continue;
+                        }
+                        
+                        if( n <= 0 )
+                        {
+                            return false;
+                        }
+                        
+                        bytes += n;
+                        size  -= static_cast< size_t >( n );
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Read( int fd, uint64_t & value )
+                {
+                    return Read( fd, &value, sizeof( value ) );
+                }
+                
+                static bool Read( int fd, std::string & value )
+                {
+                    uint64_t length;
+                    
+                    if( Read( fd, length ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    value.resize( static_cast< size_t >( length ) );
+                    
+                    return length == 0 || Read( fd, &( value[ 0 ] ), value.length() );
+                }
+                
+                static bool Read( int fd, Failure & failure )
+                {
+                    std::string expression;
+                    std::string evaluated;
+                    std::string expected;
+                    std::string actual;
+                    std::string file;
+                    std::string description;
+                    uint64_t    line;
+                    
+                    if
+                    (
+                           Read( fd, expression ) == false
+                        || Read( fd, evaluated ) == false
+                        || Read( fd, expected ) == false
+                        || Read( fd, actual ) == false
+                        || Read( fd, file ) == false
+                        || Read( fd, description ) == false
+                        || Read( fd, line ) == false
+                    )
+                    {
+                        return false;
+                    }
+                    
+                    if( expression.length() > 0 )
+                    {
+                        failure = Failure( expression, evaluated, expected, actual, file, static_cast< size_t >( line ) );
+                    }
+                    else
+                    {
+                        failure = Failure( description, file, static_cast< size_t >( line ) );
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Read( int fd, std::vector< Failure > & failures )
+                {
+                    uint64_t count;
+                    
+                    if( Read( fd, count ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    failures.clear();
+                    failures.reserve( static_cast< size_t >( count ) );
+                    
+                    for( uint64_t i = 0; i < count; i++ )
+                    {
+                        Failure failure( "", "", 0 );
+                        
+                        if( Read( fd, failure ) == false )
+                        {
+                            return false;
+                        }
+                        
+                        failures.push_back( std::move( failure ) );
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Read( int fd, std::vector< std::pair< std::string, Failure > > & failures )
+                {
+                    uint64_t count;
+                    
+                    if( Read( fd, count ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    for( uint64_t i = 0; i < count; i++ )
+                    {
+                        std::string name;
+                        Failure     failure( "", "", 0 );
+                        
+                        if( Read( fd, name ) == false || Read( fd, failure ) == false )
+                        {
+                            return false;
+                        }
+                        
+                        failures.push_back( { std::move( name ), std::move( failure ) } );
+                    }
+                    
+                    return true;
+                }
+                
+                static bool Read( int fd, Optional< Benchmark > & benchmark )
+                {
+                    uint64_t              iterations;
+                    uint64_t              count;
+                    std::vector< double > samples;
+                    
+                    if( Read( fd, iterations ) == false || Read( fd, count ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    samples.resize( static_cast< size_t >( count ) );
+                    
+                    if( count > 0 && Read( fd, samples.data(), samples.size() * sizeof( double ) ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    benchmark = Benchmark( static_cast< size_t >( iterations ), Statistics( std::move( samples ) ) );
+                    
+                    return true;
+                }
+                
+                static bool Read( int fd, Allocations & allocations )
+                {
+                    uint64_t count;
+                    uint64_t bytes;
+                    uint64_t peak;
+                    
+                    if( Read( fd, count ) == false || Read( fd, bytes ) == false || Read( fd, peak ) == false )
+                    {
+                        return false;
+                    }
+                    
+                    allocations = Allocations( count, bytes, peak );
+                    
+                    return true;
+                }
+                
+                static bool Read( int fd, ResourceUsage & usage )
+                {
+                    uint64_t values[ 7 ];
+                    
+                    for( auto & value: values )
+                    {
+                        if( Read( fd, value ) == false )
+                        {
+                            return false;
+                        }
+                    }
+                    
+                    usage = ResourceUsage
+                    (
+                        std::chrono::microseconds( static_cast< int64_t >( values[ 0 ] ) ),
+                        std::chrono::microseconds( static_cast< int64_t >( values[ 1 ] ) ),
+                        values[ 2 ],
+                        values[ 3 ],
+                        values[ 4 ],
+                        values[ 5 ],
+                        values[ 6 ]
+                    );
+                    
+                    return true;
+                }
+                
+                Optional< std::reference_wrapper< std::ostream > > _os;
+                std::mutex                                       & _output;
+                Watchdog                                         & _watchdog;
+                pid_t                                              _zygote;
+                int                                                _socket;
+                std::vector< Worker >                              _workers;
+                std::vector< size_t >                              _idle;
+                std::mutex                                         _mutex;
+                std::mutex                                         _requests;
+        };
+    }
+}
+
+#endif
+
+#endif /* XS_TEST_ISOLATION_HPP */
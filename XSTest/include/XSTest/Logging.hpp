@@ -33,11 +33,29 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <sstream>
+#include <memory>
+#include <streambuf>
+#include <cstdio>
+#include <cstring>
+#include <csignal>
 #include <XSTest/Flags.hpp>
 #include <XSTest/Optional.hpp>
 #include <XSTest/TermColor.hpp>
 #include <XSTest/Failure.hpp>
+#include <XSTest/Benchmark.hpp>
+#include <XSTest/Allocations.hpp>
+#include <XSTest/ResourceUsage.hpp>
+#include <XSTest/Repetition.hpp>
+#include <XSTest/StopWatch.hpp>
+#include <XSTest/Utility.hpp>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace XS
 {
@@ -55,7 +73,307 @@ namespace XS
             enum class Options: unsigned int
             {
                 NewLineBefore = 0x01,
-                NewLineAfter  = 0x02
+                NewLineAfter  = 0x02,
+                Detail        = 0x04
+            };
+            
+            enum class FlushMode
+            {
+                Auto,
+                Line,
+                Suite
+            };
+            
+            class Settings
+            {
+                public:
+                    
+                    FlushMode flush   = FlushMode::Auto;
+                    bool      quiet   = false;
+                    bool      verbose = false;
+            };
+            
+            inline Settings & SharedSettings()
+            {
+                static Settings settings;
+                
+                return settings;
+            }
+            
+            inline FlushMode GetFlushMode()
+            {
+                return SharedSettings().flush;
+            }
+            
+            inline void SetFlushMode( FlushMode flush )
+            {
+                SharedSettings().flush = flush;
+            }
+            
+            inline bool IsQuiet()
+            {
+                return SharedSettings().quiet;
+            }
+            
+            inline void SetQuiet( bool quiet )
+            {
+                SharedSettings().quiet = quiet;
+            }
+            
+            inline bool IsVerbose()
+            {
+                return SharedSettings().verbose;
+            }
+            
+            inline void SetVerbose( bool verbose )
+            {
+                SharedSettings().verbose = verbose;
+            }
+            
+            inline bool IsTerminal( std::ostream & os )
+            {
+                #ifdef _WIN32
+                
+                if( std::addressof( os ) == std::addressof( std::cout ) )
+                {
+                    return _isatty( _fileno( stdout ) ) != 0;
+                }
+                else if( std::addressof( os ) == std::addressof( std::cerr ) )
+                {
+                    return _isatty( _fileno( stderr ) ) != 0;
+                }
+                
+                #else
+                
+                if( std::addressof( os ) == std::addressof( std::cout ) )
+                {
+                    return isatty( fileno( stdout ) ) != 0;
+                }
+                else if( std::addressof( os ) == std::addressof( std::cerr ) )
+                {
+                    return isatty( fileno( stderr ) ) != 0;
+                }
+                
+                #endif
+                
+                return false;
+            }
+            
+            inline void Flush( Optional< std::reference_wrapper< std::ostream > > os )
+            {
+                if( os.HasValue() )
+                {
+                    os->get().flush();
+                }
+            }
+            
+            inline void EndLine( Optional< std::reference_wrapper< std::ostream > > os )
+            {
+                if( GetFlushMode() != FlushMode::Suite )
+                {
+                    Flush( os );
+                }
+            }
+            
+            /*
+             * Buffers the output in advance, so pending output can be written
+             * from a signal handler, where flushing the stream isn't safe.
+             */
+            class CrashBuffer: public std::streambuf
+            {
+                public:
+                    
+                    CrashBuffer( int fd, std::streambuf * next ):
+                        _fd(   fd ),
+                        _next( next )
+                    {
+                        this->setp( this->_buffer, this->_buffer + sizeof( this->_buffer ) );
+                    }
+                    
+                    CrashBuffer( const CrashBuffer & o )              = delete;
+                    CrashBuffer & operator =( const CrashBuffer & o ) = delete;
+                    
+                    std::streambuf * GetNext() const noexcept
+                    {
+                        return this->_next;
+                    }
+                    
+                    void WritePending() const noexcept
+                    {
+                        const char * p( this->pbase() );
+                        
+                        while( p < this->pptr() )
+                        {
+                            #ifdef _WIN32
+                            int n( _write( this->_fd, p, static_cast< unsigned int >( this->pptr() - p ) ) );
+                            #else
+                            ssize_t n( write( this->_fd, p, static_cast< size_t >( this->pptr() - p ) ) );
+                            #endif
+                            
+                            if( n <= 0 )
+                            {
+                                break;
+                            }
+                            
+                            p += n;
+                        }
+                    }
+                    
+                protected:
+                    
+                    int_type overflow( int_type c ) override
+                    {
+                        if( this->sync() != 0 )
+                        {
+                            return traits_type::eof();
+                        }
+                        
+                        if( traits_type::eq_int_type( c, traits_type::eof() ) == false )
+                        {
+                            *( this->pptr() ) = traits_type::to_char_type( c );
+                            
+                            this->pbump( 1 );
+                        }
+                        
+                        return traits_type::not_eof( c );
+                    }
+                    
+                    int sync() override
+                    {
+                        std::streamsize size( this->pptr() - this->pbase() );
+                        
+                        if( size > 0 && this->_next->sputn( this->pbase(), size ) != size )
+                        {
+                            return -1;
+                        }
+                        
+                        this->setp( this->_buffer, this->_buffer + sizeof( this->_buffer ) );
+                        
+                        return this->_next->pubsync();
+                    }
+                    
+                private:
+                    
+                    int              _fd;
+                    std::streambuf * _next;
+                    char             _buffer[ 65536 ];
+            };
+            
+            inline CrashBuffer * & CurrentCrashBuffer()
+            {
+                static CrashBuffer * buffer( nullptr );
+                
+                return buffer;
+            }
+            
+            inline void FlushOnCrash( Optional< std::reference_wrapper< std::ostream > > os )
+            {
+                int fd( -1 );
+                
+                if( os.HasValue() && std::addressof( os->get() ) == std::addressof( std::cout ) )
+                {
+                    fd = fileno( stdout );
+                }
+                else if( os.HasValue() && std::addressof( os->get() ) == std::addressof( std::cerr ) )
+                {
+                    fd = fileno( stderr );
+                }
+                
+                /* Only standard streams are backed by a known file descriptor */
+                if( fd == -1 )
+                {
+                    CurrentCrashBuffer() = nullptr;
+                }
+                else if( os->get().rdbuf() != CurrentCrashBuffer() )
+                {
+                    os->get().flush();
+                    
+                    CurrentCrashBuffer() = new CrashBuffer( fd, os->get().rdbuf() );
+                    
+                    os->get().rdbuf( CurrentCrashBuffer() );
+                }
+                
+                auto handler = []( int sig )
+                {
+                    if( CurrentCrashBuffer() != nullptr )
+                    {
+                        CurrentCrashBuffer()->WritePending();
+                    }
+                    
+                    #ifdef _WIN32
+                    signal( sig, SIG_DFL );
+                    #endif
+                    
+                    raise( sig );
+                };
+                
+                #ifdef _WIN32
+                
+                signal( SIGSEGV, handler );
+                signal( SIGABRT, handler );
+                signal( SIGFPE,  handler );
+                signal( SIGILL,  handler );
+                
+                #else
+                
+                struct sigaction action;
+                
+                memset( &action, 0, sizeof( action ) );
+                sigemptyset( &( action.sa_mask ) );
+                
+                /* The default action is restored when the handler is called, so raising the signal again terminates the process */
+                action.sa_handler = handler;
+                action.sa_flags   = SA_RESETHAND;
+                
+                sigaction( SIGSEGV, &action, nullptr );
+                sigaction( SIGABRT, &action, nullptr );
+                sigaction( SIGFPE,  &action, nullptr );
+                sigaction( SIGILL,  &action, nullptr );
+                sigaction( SIGBUS,  &action, nullptr );
+                
+                #endif
+            }
+            
+            inline void StopFlushingOnCrash( Optional< std::reference_wrapper< std::ostream > > os )
+            {
+                CrashBuffer * buffer( CurrentCrashBuffer() );
+                
+                if( buffer == nullptr || os.HasValue() == false || os->get().rdbuf() != buffer )
+                {
+                    return;
+                }
+                
+                os->get().flush();
+                
+                /* Cleared first, so the signal handler never writes from a deleted buffer */
+                CurrentCrashBuffer() = nullptr;
+                
+                os->get().rdbuf( buffer->GetNext() );
+                
+                delete buffer;
+            }
+            
+            class CrashFlushing
+            {
+                public:
+                    
+                    explicit CrashFlushing( Optional< std::reference_wrapper< std::ostream > > os ):
+                        _os( os )
+                    {
+                        FlushOnCrash( os );
+                    }
+                    
+                    ~CrashFlushing()
+                    {
+                        StopFlushingOnCrash( this->_os );
+                    }
+                    
+                    CrashFlushing( const CrashFlushing & o )              = delete;
+                    CrashFlushing & operator =( const CrashFlushing & o ) = delete;
+                    
+                private:
+                    
+                    Optional< std::reference_wrapper< std::ostream > > _os;
             };
             
             inline void SuccessPrompt( Optional< std::reference_wrapper< std::ostream > > os )
@@ -97,14 +415,15 @@ namespace XS
                 Flags< Options > options = {}
             )
             {
-                if( os.HasValue() == false )
+                /* Detail messages are left out with --quiet */
+                if( os.HasValue() == false || ( options.HasFlag( Options::Detail ) && IsQuiet() ) )
                 {
                     return;
                 }
                 
                 if( options.HasFlag( Options::NewLineBefore ) )
                 {
-                    os->get() << std::endl;
+                    os->get() << '\n';
                 }
                 
                 if( style == Style::Success )
@@ -125,20 +444,22 @@ namespace XS
                     os->get() << *( color );
                 }
                 
-                os->get() << message << TermColor::None() << std::endl;
+                os->get() << message << TermColor::None() << '\n';
                 
                 if( options.HasFlag( Options::NewLineAfter ) )
                 {
-                    os->get() << std::endl;
+                    os->get() << '\n';
                 }
+                
+                EndLine( os );
             }
             
             inline void Log
             (
                 Optional< std::reference_wrapper< std::ostream > > os,
-                const std::string & testSuite,
-                const std::string & testCase,
-                const std::string & prefix
+                const char * testSuite,
+                const char * testCase,
+                const char * prefix
             )
             {
                 if( os.HasValue() == false )
@@ -154,7 +475,9 @@ namespace XS
                           << TermColor::Magenta()
                           << testCase
                           << TermColor::None()
-                          << std::endl;
+                          << '\n';
+                
+                EndLine( os );
             }
             
             inline void Log
@@ -162,8 +485,77 @@ namespace XS
                 Optional< std::reference_wrapper< std::ostream > > os,
                 const std::string & testSuite,
                 const std::string & testCase,
-                Optional< Failure > failure,
-                const StopWatch & time
+                const std::string & prefix
+            )
+            {
+                Log( os, testSuite.c_str(), testCase.c_str(), prefix.c_str() );
+            }
+            
+            inline std::string Usage( const StopWatch & time, const Optional< Allocations > & allocations, const Optional< ResourceUsage > & resources )
+            {
+                /* Details make the output several times longer, so they're only shown on demand */
+                if( IsVerbose() == false )
+                {
+                    return "";
+                }
+                
+                std::string usage( " (CPU: " + StopWatch::Format( time.GetThreadCPUTime() ) );
+                
+                /* getrusage splits CPU time with the granularity of scheduler ticks, so the split is meaningless for short test cases */
+                if( resources.HasValue() && resources->GetUserTime() + resources->GetSystemTime() >= std::chrono::milliseconds( 50 ) )
+                {
+                    usage += ", user: "
+                          +  StopWatch::Format( resources->GetUserTime() )
+                          +  ", system: "
+                          +  StopWatch::Format( resources->GetSystemTime() );
+                }
+                
+                if( allocations.HasValue() )
+                {
+                    usage += ", "
+                          +  Utility::Numbered( "allocation", static_cast< size_t >( allocations->GetCount() ) )
+                          +  ", "
+                          +  Utility::Numbered( "byte", static_cast< size_t >( allocations->GetBytes() ) )
+                          +  ", peak: "
+                          +  Utility::Numbered( "byte", static_cast< size_t >( allocations->GetPeak() ) );
+                }
+                
+                /* Only unusual activity is shown, to keep the output readable */
+                if( resources.HasValue() && resources->GetMaxRSS() > 0 )
+                {
+                    usage += ", max RSS: +" + std::to_string( resources->GetMaxRSS() / 1024 ) + " KB";
+                }
+                
+                if( resources.HasValue() && ( resources->GetMinorFaults() > 0 || resources->GetMajorFaults() > 0 ) )
+                {
+                    usage += ", page faults: "
+                          +  std::to_string( resources->GetMinorFaults() )
+                          +  " minor / "
+                          +  std::to_string( resources->GetMajorFaults() )
+                          +  " major";
+                }
+                
+                if( resources.HasValue() && ( resources->GetVoluntarySwitches() > 0 || resources->GetInvoluntarySwitches() > 0 ) )
+                {
+                    usage += ", context switches: "
+                          +  std::to_string( resources->GetVoluntarySwitches() )
+                          +  " voluntary / "
+                          +  std::to_string( resources->GetInvoluntarySwitches() )
+                          +  " involuntary";
+                }
+                
+                return usage + ")";
+            }
+            
+            inline void Log
+            (
+                Optional< std::reference_wrapper< std::ostream > > os,
+                const std::string & testSuite,
+                const std::string & testCase,
+                const std::vector< Failure > & failures,
+                const StopWatch & time,
+                Optional< Allocations > allocations = {},
+                Optional< ResourceUsage > resources = {}
             )
             {
                 if( os.HasValue() == false )
@@ -171,7 +563,7 @@ namespace XS
                     return;
                 }
                 
-                if( failure.HasValue() )
+                if( failures.size() > 0 )
                 {
                     Logging::FailedPrompt( os );
                     
@@ -184,25 +576,27 @@ namespace XS
                               << TermColor::None()
                               << " - "
                               << time.GetString()
-                              << std::endl;
+                              << Usage( time, allocations, resources )
+                              << '\n';
                 
+                    for( const auto & failure: failures )
                     {
-                        std::string file( ( failure->GetFile().length() > 0 ) ? failure->GetFile() : "<unknown>" );
-                        std::string expression( failure->GetExpression() );
-                        std::string evaluated( failure->GetEvaluated() );
-                        std::string expected( failure->GetExpected() );
-                        std::string actual( failure->GetActual() );
+                        std::string file( ( failure.GetFile().length() > 0 ) ? failure.GetFile() : "<unknown>" );
+                        std::string expression( failure.GetExpression() );
+                        std::string evaluated( failure.GetEvaluated() );
+                        std::string expected( failure.GetExpected() );
+                        std::string actual( failure.GetActual() );
                             
                         os->get() << "            - File:       "
                                   << TermColor::Yellow()
                                   << file
                                   << ":"
-                                  << std::to_string( failure->GetLine() )
+                                  << std::to_string( failure.GetLine() )
                                   << TermColor::None();
                                   
                         if( expression.length() > 0 )
                         {
-                            os->get() << std::endl
+                            os->get() << '\n'
                                       << "            - Expression: "
                                       << TermColor::Cyan()
                                       << expression
@@ -210,7 +604,7 @@ namespace XS
                             
                             if( evaluated.length() > 0 && evaluated != expression )
                             {
-                                os->get() << std::endl
+                                os->get() << '\n'
                                           << "            - Evaluated:  "
                                           << TermColor::Blue()
                                           << evaluated
@@ -219,7 +613,7 @@ namespace XS
                             
                             if( expected.length() > 0 )
                             {
-                                os->get() << std::endl
+                                os->get() << '\n'
                                           << "            - Expected:   "
                                           << TermColor::Green()
                                           << expected
@@ -228,7 +622,7 @@ namespace XS
                             
                             if( actual.length() > 0 )
                             {
-                                os->get() << std::endl
+                                os->get() << '\n'
                                           << "            - Actual:     "
                                           << TermColor::Red()
                                           << actual
@@ -237,18 +631,23 @@ namespace XS
                         }
                         else
                         {
-                            os->get() << std::endl
+                            os->get() << '\n'
                                       << "            - Reason:     "
                                       << TermColor::Red()
-                                      << failure->GetDescription()
+                                      << failure.GetDescription()
                                       << TermColor::None();
                         }
+                        
+                        os->get() << '\n';
                     }
-                    
-                    os->get() << std::endl;
                 }
                 else
                 {
+                    if( IsQuiet() )
+                    {
+                        return;
+                    }
+                    
                     Logging::SuccessPrompt( os );
                     
                     os->get() << TermColor::Blue()
@@ -260,9 +659,120 @@ namespace XS
                               << TermColor::None()
                               << " - "
                               << time.GetString()
+                              << Usage( time, allocations, resources )
                               << TermColor::None()
-                              << std::endl;
+                              << '\n';
                 }
+                
+                EndLine( os );
+            }
+            
+            inline void Log
+            (
+                Optional< std::reference_wrapper< std::ostream > > os,
+                const std::string & testSuite,
+                const std::string & testCase,
+                Optional< Failure > failure,
+                const StopWatch & time,
+                Optional< Allocations > allocations = {},
+                Optional< ResourceUsage > resources = {}
+            )
+            {
+                Log( os, testSuite, testCase, ( failure.HasValue() ) ? std::vector< Failure >( 1, failure.Value() ) : std::vector< Failure >(), time, allocations, resources );
+            }
+            
+            inline void Log( Optional< std::reference_wrapper< std::ostream > > os, const Benchmark & benchmark )
+            {
+                if( os.HasValue() == false || IsQuiet() )
+                {
+                    return;
+                }
+                
+                os->get() << "            - Iterations: "
+                          << TermColor::Cyan()
+                          << Utility::Numbered( "iteration", benchmark.GetIterations() )
+                          << " x "
+                          << Utility::Numbered( "sample", benchmark.GetStatistics().GetCount() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Mean:       "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( benchmark.GetStatistics().GetMean() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Median:     "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( benchmark.GetStatistics().GetMedian() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Std. dev.:  "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( benchmark.GetStatistics().GetStandardDeviation() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Min:        "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( benchmark.GetStatistics().GetMin() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Throughput: "
+                          << TermColor::Green()
+                          << Benchmark::FormatRate( benchmark.GetThroughput() )
+                          << TermColor::None()
+                          << '\n';
+                
+                EndLine( os );
+            }
+            
+            inline void Log( Optional< std::reference_wrapper< std::ostream > > os, const Repetition & repetition )
+            {
+                if( os.HasValue() == false || ( IsQuiet() && repetition.GetFailedRuns() == 0 ) )
+                {
+                    return;
+                }
+                
+                os->get() << "            - Runs:       "
+                          << TermColor::Cyan()
+                          << Utility::Numbered( "run", repetition.GetRuns() )
+                          << TermColor::None()
+                          << " ("
+                          << TermColor::Green()
+                          << std::to_string( repetition.GetPassedRuns() )
+                          << " passed"
+                          << TermColor::None()
+                          << ", "
+                          << ( ( repetition.GetFailedRuns() > 0 ) ? TermColor::Red() : TermColor::None() )
+                          << std::to_string( repetition.GetFailedRuns() )
+                          << " failed"
+                          << TermColor::None()
+                          << ")\n"
+                          << "            - Mean:       "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( repetition.GetDurations().GetMean() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Median:     "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( repetition.GetDurations().GetMedian() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Std. dev.:  "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( repetition.GetDurations().GetStandardDeviation() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Min:        "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( repetition.GetDurations().GetMin() )
+                          << TermColor::None()
+                          << '\n'
+                          << "            - Max:        "
+                          << TermColor::Yellow()
+                          << Benchmark::FormatTime( repetition.GetDurations().GetMax() )
+                          << TermColor::None()
+                          << '\n';
+                
+                EndLine( os );
             }
         }
     }
@@ -71,10 +71,30 @@ namespace testing
 #define ASSERT_DOUBLE_EQ( _v1_, _v2_ )      XSTestAssertDoubleEqual( _v1_, _v2_ )
 #define ASSERT_LONGDOUBLE_EQ( _v1_, _v2_ )  XSTestAssertLongDoubleEqual( _v1_, _v2_ )
 #define ASSERT_NO_FATAL_FAILURE( _e_ )      _e_
+#define EXPECT_FALSE( _e_ )                 XSTestExpectFalse( _e_ )
+#define EXPECT_TRUE( _e_ )                  XSTestExpectTrue( _e_ )
+#define EXPECT_EQ( _v1_, _v2_ )             XSTestExpectEqual( _v1_, _v2_ )
+#define EXPECT_NE( _v1_, _v2_ )             XSTestExpectNotEqual( _v1_, _v2_ )
+#define EXPECT_LT( _v1_, _v2_ )             XSTestExpectLess( _v1_, _v2_ )
+#define EXPECT_LE( _v1_, _v2_ )             XSTestExpectLessOrEqual( _v1_, _v2_ )
+#define EXPECT_GT( _v1_, _v2_ )             XSTestExpectGreater( _v1_, _v2_ )
+#define EXPECT_GE( _v1_, _v2_ )             XSTestExpectGreaterOrEqual( _v1_, _v2_ )
+#define EXPECT_STREQ( _s1_, _s2_ )          XSTestExpectStringEqual( _s1_, _s2_ )
+#define EXPECT_STRNE( _s1_, _s2_ )          XSTestExpectStringNotEqual( _s1_, _s2_ )
+#define EXPECT_STRCASEEQ( _s1_, _s2_ )      XSTestExpectStringEqualCaseInsensitive( _s1_, _s2_ )
+#define EXPECT_STRCASENE( _s1_, _s2_ )      XSTestExpectStringNotEqualCaseInsensitive( _s1_, _s2_ )
+#define EXPECT_THROW( _e_, _ex_ )           XSTestExpectThrow( _e_, _ex_ )
+#define EXPECT_NO_THROW( _e_ )              XSTestExpectNoThrow( _e_ )
+#define EXPECT_ANY_THROW( _e_ )             XSTestExpectAnyThrow( _e_ )
+#define EXPECT_FLOAT_EQ( _v1_, _v2_ )       XSTestExpectFloatEqual( _v1_, _v2_ )
+#define EXPECT_DOUBLE_EQ( _v1_, _v2_ )      XSTestExpectDoubleEqual( _v1_, _v2_ )
+#define EXPECT_LONGDOUBLE_EQ( _v1_, _v2_ )  XSTestExpectLongDoubleEqual( _v1_, _v2_ )
 
 #ifdef _WIN32
 #define ASSERT_HRESULT_SUCCEEDED( _e_ )     XSTestAssertHResultSucceeded( _e_ )
 #define ASSERT_HRESULT_FAILED( _e_ )        XSTestAssertHResultFailed( _e_ )
+#define EXPECT_HRESULT_SUCCEEDED( _e_ )     XSTestExpectHResultSucceeded( _e_ )
+#define EXPECT_HRESULT_FAILED( _e_ )        XSTestExpectHResultFailed( _e_ )
 #endif
 
 #endif
@@ -85,38 +105,79 @@ namespace testing
 
 #define XSTestAssertTrue( _e_ )                                 XS::Test::Assert::Boolean( static_cast< bool >( _e_ ), true,  XSTest_Internal_XString( _e_ ), __FILE__, __LINE__ )
 #define XSTestAssertFalse( _e_ )                                XS::Test::Assert::Boolean( static_cast< bool >( _e_ ), false, XSTest_Internal_XString( _e_ ), __FILE__, __LINE__ )
-#define XSTestAssertEqual( _v1_, _v2_ )                         XS::Test::Assert::CompareEqual(          _v1_, _v2_, std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertNotEqual( _v1_, _v2_ )                      XS::Test::Assert::CompareNotEqual(       _v1_, _v2_, std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertLess( _v1_, _v2_ )                          XS::Test::Assert::CompareLess(           _v1_, _v2_, std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertLessOrEqual( _v1_, _v2_ )                   XS::Test::Assert::CompareLessOrEqual(    _v1_, _v2_, std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertGreater( _v1_, _v2_ )                       XS::Test::Assert::CompareGreater(        _v1_, _v2_, std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertGreaterOrEqual( _v1_, _v2_ )                XS::Test::Assert::CompareGreaterOrEqual( _v1_, _v2_, std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertStringEqual( _s1_, _s2_ )                   XS::Test::Assert::StringEquality( _s1_, _s2_, true,  false, std::string( XSTest_Internal_XString( _s1_ ) ), std::string( XSTest_Internal_XString( _s2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertStringNotEqual( _s1_, _s2_ )                XS::Test::Assert::StringEquality( _s1_, _s2_, false, false, std::string( XSTest_Internal_XString( _s1_ ) ), std::string( XSTest_Internal_XString( _s2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertStringEqualCaseInsensitive( _s1_, _s2_ )    XS::Test::Assert::StringEquality( _s1_, _s2_, true,  true,  std::string( XSTest_Internal_XString( _s1_ ) ), std::string( XSTest_Internal_XString( _s2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertStringNotEqualCaseInsensitive( _s1_, _s2_ ) XS::Test::Assert::StringEquality( _s1_, _s2_, false, true,  std::string( XSTest_Internal_XString( _s1_ ) ), std::string( XSTest_Internal_XString( _s2_ ) ), __FILE__, __LINE__ )
+#define XSTestAssertEqual( _v1_, _v2_ )                         XS::Test::Assert::CompareEqual(          _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertNotEqual( _v1_, _v2_ )                      XS::Test::Assert::CompareNotEqual(       _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertLess( _v1_, _v2_ )                          XS::Test::Assert::CompareLess(           _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertLessOrEqual( _v1_, _v2_ )                   XS::Test::Assert::CompareLessOrEqual(    _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertGreater( _v1_, _v2_ )                       XS::Test::Assert::CompareGreater(        _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertGreaterOrEqual( _v1_, _v2_ )                XS::Test::Assert::CompareGreaterOrEqual( _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertStringEqual( _s1_, _s2_ )                   XS::Test::Assert::StringEquality( _s1_, _s2_, true,  false, XSTest_Internal_XString( _s1_ ), XSTest_Internal_XString( _s2_ ), __FILE__, __LINE__ )
+#define XSTestAssertStringNotEqual( _s1_, _s2_ )                XS::Test::Assert::StringEquality( _s1_, _s2_, false, false, XSTest_Internal_XString( _s1_ ), XSTest_Internal_XString( _s2_ ), __FILE__, __LINE__ )
+#define XSTestAssertStringEqualCaseInsensitive( _s1_, _s2_ )    XS::Test::Assert::StringEquality( _s1_, _s2_, true,  true,  XSTest_Internal_XString( _s1_ ), XSTest_Internal_XString( _s2_ ), __FILE__, __LINE__ )
+#define XSTestAssertStringNotEqualCaseInsensitive( _s1_, _s2_ ) XS::Test::Assert::StringEquality( _s1_, _s2_, false, true,  XSTest_Internal_XString( _s1_ ), XSTest_Internal_XString( _s2_ ), __FILE__, __LINE__ )
 #define XSTestAssertThrow( _e_, _ex_ )                          XS::Test::Assert::Throwing< _ex_ >( [ & ]() { _e_; }, XSTest_Internal_XString( _ex_ ), XSTest_Internal_XString( _e_ ), __FILE__, __LINE__ )
 #define XSTestAssertNoThrow( _e_ )                              XS::Test::Assert::Throwing( [ & ]() { _e_; }, false,  XSTest_Internal_XString( _e_ ), __FILE__, __LINE__ )
 #define XSTestAssertAnyThrow( _e_ )                             XS::Test::Assert::Throwing( [ & ]() { _e_; }, true,   XSTest_Internal_XString( _e_ ), __FILE__, __LINE__ ) 
-#define XSTestAssertFloatEqual( _v1_, _v2_ )                    XS::Test::Assert::CompareEqual( static_cast< float       >( _v1_ ), static_cast< float       >( _v2_ ), std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertFloatNotEqual( _v1_, _v2_ )                 XS::Test::Assert::CompareNotEqual( static_cast< float       >( _v1_ ), static_cast< float       >( _v2_ ), std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertDoubleEqual( _v1_, _v2_ )                   XS::Test::Assert::CompareEqual( static_cast< double      >( _v1_ ), static_cast< double      >( _v2_ ), std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
-#define XSTestAssertDoubleNotEqual( _v1_, _v2_ )                XS::Test::Assert::CompareNotEqual( static_cast< double      >( _v1_ ), static_cast< double      >( _v2_ ), std::string( XSTest_Internal_XString( _v1_ ) ), std::string( XSTest_Internal_XString( _v2_ ) ), __FILE__, __LINE__ )
+#define XSTestAssertFloatEqual( _v1_, _v2_ )                    XS::Test::Assert::CompareEqual( static_cast< float       >( _v1_ ), static_cast< float       >( _v2_ ), XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertFloatNotEqual( _v1_, _v2_ )                 XS::Test::Assert::CompareNotEqual( static_cast< float       >( _v1_ ), static_cast< float       >( _v2_ ), XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertDoubleEqual( _v1_, _v2_ )                   XS::Test::Assert::CompareEqual( static_cast< double      >( _v1_ ), static_cast< double      >( _v2_ ), XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertDoubleNotEqual( _v1_, _v2_ )                XS::Test::Assert::CompareNotEqual( static_cast< double      >( _v1_ ), static_cast< double      >( _v2_ ), XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__ )
+#define XSTestAssertMaxAllocations( _e_, _n_ )                  XS::Test::Assert::MaxAllocations( [ & ]() { _e_; }, _n_, XSTest_Internal_XString( _e_ ), __FILE__, __LINE__ )
+#define XSTestAssertProperty( _g_, ... )                        XS::Test::Property::Check( _g_, __VA_ARGS__, XSTest_Internal_VAString( __VA_ARGS__ ), __FILE__, __LINE__ )
 
 #ifdef _WIN32
 #define XSTestAssertHResultSucceeded( _e_ )                     XS::Test::Assert::HResult( _e_, true,  XSTest_Internal_XString( _e_ ), __FILE__, __LINE__ )
 #define XSTestAssertHResultFailed( _e_ )                        XS::Test::Assert::HResult( _e_, false, XSTest_Internal_XString( _e_ ), __FILE__, __LINE__ )
 #endif
 
+#define XSTestExpectTrue( _e_ )                                 XS::Test::Assert::Boolean( static_cast< bool >( _e_ ), true,  XSTest_Internal_XString( _e_ ), __FILE__, __LINE__, false )
+#define XSTestExpectFalse( _e_ )                                XS::Test::Assert::Boolean( static_cast< bool >( _e_ ), false, XSTest_Internal_XString( _e_ ), __FILE__, __LINE__, false )
+#define XSTestExpectEqual( _v1_, _v2_ )                         XS::Test::Assert::CompareEqual(          _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectNotEqual( _v1_, _v2_ )                      XS::Test::Assert::CompareNotEqual(       _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectLess( _v1_, _v2_ )                          XS::Test::Assert::CompareLess(           _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectLessOrEqual( _v1_, _v2_ )                   XS::Test::Assert::CompareLessOrEqual(    _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectGreater( _v1_, _v2_ )                       XS::Test::Assert::CompareGreater(        _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectGreaterOrEqual( _v1_, _v2_ )                XS::Test::Assert::CompareGreaterOrEqual( _v1_, _v2_, XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectStringEqual( _s1_, _s2_ )                   XS::Test::Assert::StringEquality( _s1_, _s2_, true,  false, XSTest_Internal_XString( _s1_ ), XSTest_Internal_XString( _s2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectStringNotEqual( _s1_, _s2_ )                XS::Test::Assert::StringEquality( _s1_, _s2_, false, false, XSTest_Internal_XString( _s1_ ), XSTest_Internal_XString( _s2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectStringEqualCaseInsensitive( _s1_, _s2_ )    XS::Test::Assert::StringEquality( _s1_, _s2_, true,  true,  XSTest_Internal_XString( _s1_ ), XSTest_Internal_XString( _s2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectStringNotEqualCaseInsensitive( _s1_, _s2_ ) XS::Test::Assert::StringEquality( _s1_, _s2_, false, true,  XSTest_Internal_XString( _s1_ ), XSTest_Internal_XString( _s2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectThrow( _e_, _ex_ )                          XS::Test::Assert::Throwing< _ex_ >( [ & ]() { _e_; }, XSTest_Internal_XString( _ex_ ), XSTest_Internal_XString( _e_ ), __FILE__, __LINE__, false )
+#define XSTestExpectNoThrow( _e_ )                              XS::Test::Assert::Throwing( [ & ]() { _e_; }, false,  XSTest_Internal_XString( _e_ ), __FILE__, __LINE__, false )
+#define XSTestExpectAnyThrow( _e_ )                             XS::Test::Assert::Throwing( [ & ]() { _e_; }, true,   XSTest_Internal_XString( _e_ ), __FILE__, __LINE__, false )
+#define XSTestExpectFloatEqual( _v1_, _v2_ )                    XS::Test::Assert::CompareEqual( static_cast< float       >( _v1_ ), static_cast< float       >( _v2_ ), XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectFloatNotEqual( _v1_, _v2_ )                 XS::Test::Assert::CompareNotEqual( static_cast< float       >( _v1_ ), static_cast< float       >( _v2_ ), XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectDoubleEqual( _v1_, _v2_ )                   XS::Test::Assert::CompareEqual( static_cast< double      >( _v1_ ), static_cast< double      >( _v2_ ), XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectDoubleNotEqual( _v1_, _v2_ )                XS::Test::Assert::CompareNotEqual( static_cast< double      >( _v1_ ), static_cast< double      >( _v2_ ), XSTest_Internal_XString( _v1_ ), XSTest_Internal_XString( _v2_ ), __FILE__, __LINE__, false )
+#define XSTestExpectMaxAllocations( _e_, _n_ )                  XS::Test::Assert::MaxAllocations( [ & ]() { _e_; }, _n_, XSTest_Internal_XString( _e_ ), __FILE__, __LINE__, false )
+#define XSTestExpectProperty( _g_, ... )                        XS::Test::Property::Check( _g_, __VA_ARGS__, XSTest_Internal_VAString( __VA_ARGS__ ), __FILE__, __LINE__, false )
+
+#ifdef _WIN32
+#define XSTestExpectHResultSucceeded( _e_ )                     XS::Test::Assert::HResult( _e_, true,  XSTest_Internal_XString( _e_ ), __FILE__, __LINE__, false )
+#define XSTestExpectHResultFailed( _e_ )                        XS::Test::Assert::HResult( _e_, false, XSTest_Internal_XString( _e_ ), __FILE__, __LINE__, false )
+#endif
+
 /*******************************************************************************
  * Test cases
  ******************************************************************************/
  
-#define XSTest( _case_, _name_ )                    XSTest_Internal_TestSetup( _case_, _name_, XSTest_Internal_ClassName( _case_, _name_ ), XS::Test::Case )
-#define XSTestFixture( _case_, _name_ )             XSTest_Internal_TestSetup( _case_, _name_, XSTest_Internal_ClassName( _case_, _name_ ), _case_ )
-#define XSTest_Internal_ClassName( _case_, _name_ ) Test_ ## _case_ ## _ ## _name_
-#define XSTest_Internal_XString( _s_ )              XSTest_Internal_String( _s_ )
-#define XSTest_Internal_String( _s_ )               #_s_
+#define XSTest( _case_, _name_ )                        XSTest_Internal_TestSetup( _case_, _name_, XSTest_Internal_ClassName( _case_, _name_ ), XS::Test::Case )
+#define XSTestFixture( _case_, _name_ )                 XSTest_Internal_TestSetup( _case_, _name_, XSTest_Internal_ClassName( _case_, _name_ ), _case_ )
+#define XSTestBenchmark( _case_, _name_ )               XSTest_Internal_Benchmark( _case_, _name_, XSTest_Internal_ClassName( _case_, _name_ ), XSTest_Internal_BenchmarkName( _case_, _name_ ), XS::Test::Case )
+#define XSTestBenchmarkFixture( _case_, _name_ )        XSTest_Internal_Benchmark( _case_, _name_, XSTest_Internal_ClassName( _case_, _name_ ), XSTest_Internal_BenchmarkName( _case_, _name_ ), _case_ )
+#define XSTestParam( _case_, _name_, _type_ )           XSTest_Internal_Param( _case_, _name_, _type_, XSTest_Internal_ClassName( _case_, _name_ ), XSTest_Internal_ParamName( _case_, _name_ ), XS::Test::Case )
+#define XSTestParamFixture( _case_, _name_, _type_ )    XSTest_Internal_Param( _case_, _name_, _type_, XSTest_Internal_ClassName( _case_, _name_ ), XSTest_Internal_ParamName( _case_, _name_ ), _case_ )
+#define XSTestInstantiate( _case_, _name_, ... )        XSTest_Internal_Instantiate( XSTest_Internal_ParamName( _case_, _name_ ), __VA_ARGS__ )
+#define XSTestInstantiateTable( _case_, _name_, _t_ )   XSTest_Internal_InstantiateTable( XSTest_Internal_ParamName( _case_, _name_ ), _t_ )
+#define XSTestTyped( _case_, _name_, ... )              XSTest_Internal_Typed( _case_, _name_, XSTest_Internal_ClassName( _case_, _name_ ), XSTest_Internal_RegistrarName( _case_, _name_ ), XS::Test::Case, __VA_ARGS__ )
+#define XSTestTypedFixture( _case_, _name_, ... )       XSTest_Internal_Typed( _case_, _name_, XSTest_Internal_ClassName( _case_, _name_ ), XSTest_Internal_RegistrarName( _case_, _name_ ), _case_< TypeParam >, __VA_ARGS__ )
+#define XSTest_Internal_ClassName( _case_, _name_ )     Test_ ## _case_ ## _ ## _name_
+#define XSTest_Internal_RegistrarName( _case_, _name_ ) Registrar_ ## _case_ ## _ ## _name_
+#define XSTest_Internal_BenchmarkName( _case_, _name_ ) Benchmark_ ## _case_ ## _ ## _name_
+#define XSTest_Internal_ParamName( _case_, _name_ )     Param_ ## _case_ ## _ ## _name_
+#define XSTest_Internal_XString( _s_ )                  XSTest_Internal_String( _s_ )
+#define XSTest_Internal_String( _s_ )                   #_s_
+#define XSTest_Internal_VAString( ... )                 #__VA_ARGS__
 
 #ifdef __clang__
 #pragma clang diagnostic ignored "-Wglobal-constructors"
@@ -124,36 +185,168 @@ namespace testing
 
 #define XSTest_Internal_TestSetup( _case_, _name_, _class_, _base_ )    \
                                                                         \
+    XSTest_Internal_Setup( _case_, _name_, _class_, _base_, nullptr )   \
+
+#define XSTest_Internal_Setup( _case_, _name_, _class_, _base_, _parameters_ ) \
+                                                                        \
     class _class_: public _base_                                        \
     {                                                                   \
         public:                                                         \
                                                                         \
             _class_() = default;                                        \
                                                                         \
+            static XS::Test::Case * _Create();                          \
+                                                                        \
         protected:                                                      \
                                                                         \
-            const XS::Test::Info & Info() override;                     \
-            void                   Test() override;                     \
+            void Test() override;                                       \
                                                                         \
         private:                                                        \
                                                                         \
-            const static XS::Test::Info & _InfoRef;                     \
+            static XS::Test::Registration    _Registration;             \
+            static const XS::Test::Registrar _Registrar;                \
     };                                                                  \
                                                                         \
-    const XS::Test::Info & _class_::_InfoRef = XS::Test::Info::Register \
+    XS::Test::Case * _class_::_Create()                                 \
+    {                                                                   \
+        return new _class_();                                           \
+    }                                                                   \
+                                                                        \
+    XS::Test::Registration _class_::_Registration                       \
     (                                                                   \
         XSTest_Internal_XString( _case_ ),                              \
         XSTest_Internal_XString( _name_ ),                              \
-        []() { return std::make_shared< _class_ >(); },                 \
+        &_class_::_Create,                                              \
         __FILE__,                                                       \
-        __LINE__                                                        \
+        __LINE__,                                                       \
+        &_class_::SetUpTestSuite,                                       \
+        &_class_::TearDownTestSuite,                                    \
+        _parameters_                                                    \
     );                                                                  \
                                                                         \
-    const XS::Test::Info & _class_::Info()                              \
+    const XS::Test::Registrar _class_::_Registrar                       \
+    (                                                                   \
+        _class_::_Registration                                          \
+    );                                                                  \
+                                                                        \
+    void _class_::Test()                                                \
+
+#define XSTest_Internal_Benchmark( _case_, _name_, _class_, _bench_, _base_ ) \
+                                                                        \
+    class _bench_: public _base_                                        \
+    {                                                                   \
+        protected:                                                      \
+                                                                        \
+            void Iteration();                                           \
+    };                                                                  \
+                                                                        \
+    XSTest_Internal_TestSetup( _case_, _name_, _class_, _bench_ )       \
     {                                                                   \
-        return _InfoRef;                                                \
+        this->RunBenchmark( [ this ]() { this->Iteration(); } );        \
     }                                                                   \
                                                                         \
-    void _class_::Test()                                                \
+    void _bench_::Iteration()                                           \
+
+#define XSTest_Internal_Param( _case_, _name_, _type_, _class_, _param_, _base_ ) \
+                                                                        \
+    class _param_: public _base_                                        \
+    {                                                                   \
+        public:                                                         \
+                                                                        \
+            typedef _type_ ParameterType;                               \
+                                                                        \
+            static XS::Test::Span< const _type_ > Parameters();         \
+                                                                        \
+            static size_t ParameterCount()                              \
+            {                                                           \
+                return Parameters().size();                             \
+            }                                                           \
+                                                                        \
+        protected:                                                      \
+                                                                        \
+            const _type_ & GetParam()                                   \
+            {                                                           \
+                return Parameters()[ this->Info().GetParameterIndex() ]; \
+            }                                                           \
+    };                                                                  \
+                                                                        \
+    XSTest_Internal_Setup( _case_, _name_, _class_, _param_, &_param_::ParameterCount ) \
+
+#define XSTest_Internal_Instantiate( _param_, ... )                     \
+                                                                        \
+    XS::Test::Span< const _param_::ParameterType > _param_::Parameters() \
+    {                                                                   \
+        static const ParameterType parameters[] = { __VA_ARGS__ };      \
+                                                                        \
+        return { parameters, sizeof( parameters ) / sizeof( parameters[ 0 ] ) }; \
+    }                                                                   \
+
+#define XSTest_Internal_InstantiateTable( _param_, _table_ )            \
+                                                                        \
+    XS::Test::Span< const _param_::ParameterType > _param_::Parameters() \
+    {                                                                   \
+        static const std::vector< ParameterType > parameters( _table_ ); \
+                                                                        \
+        return { parameters.data(), parameters.size() };                \
+    }                                                                   \
+
+#define XSTest_Internal_Typed( _case_, _name_, _class_, _registrar_, _base_, ... ) \
+                                                                        \
+    template< typename TypeParam >                                      \
+    class _class_: public _base_                                        \
+    {                                                                   \
+        public:                                                         \
+                                                                        \
+            _class_() = default;                                        \
+                                                                        \
+            static XS::Test::Case * _Create()                           \
+            {                                                           \
+                return new _class_();                                   \
+            }                                                           \
+                                                                        \
+        protected:                                                      \
+                                                                        \
+            void Test() override;                                       \
+    };                                                                  \
+                                                                        \
+    static const XS::Test::TypedRegistrar< _class_, __VA_ARGS__ > _registrar_ \
+    (                                                                   \
+        XSTest_Internal_XString( _case_ ),                              \
+        XSTest_Internal_XString( _name_ ),                              \
+        __FILE__,                                                       \
+        __LINE__                                                        \
+    );                                                                  \
+                                                                        \
+    template< typename TypeParam >                                      \
+    void _class_< TypeParam >::Test()                                   \
+
+/*******************************************************************************
+ * Resources
+ ******************************************************************************/
+
+#define XSTestResource( _name_, _type_ )                XSTest_Internal_Resource( _name_, _type_, XSTest_Internal_ResourceName( _name_ ), XSTest_Internal_ResourceCreate( _name_ ) )
+#define XSTestResourceDeclaration( _name_, _type_ )     extern XS::Test::Environment::Resource< _type_ > XSTest_Internal_ResourceName( _name_ )
+#define XSTestGetResource( _name_ )                     XSTest_Internal_ResourceName( _name_ ).Get()
+#define XSTestUseResource( _suite_, _name_ )            static XS::Test::Environment::Use Resource_ ## _name_ ## _ ## _suite_ ## _Use( XSTest_Internal_XString( _suite_ ), XSTest_Internal_ResourceName( _name_ ) )
+#define XSTest_Internal_ResourceName( _name_ )          Resource_ ## _name_
+#define XSTest_Internal_ResourceCreate( _name_ )        Resource_ ## _name_ ## _Create
+
+#define XSTest_Internal_Resource( _name_, _type_, _resource_, _create_ ) \
+                                                                        \
+    static std::shared_ptr< _type_ > _create_();                        \
+                                                                        \
+    XS::Test::Environment::Resource< _type_ > _resource_                \
+    (                                                                   \
+        XSTest_Internal_XString( _name_ ),                              \
+        &_create_                                                       \
+    );                                                                  \
+                                                                        \
+    static std::shared_ptr< _type_ > _create_()                         \
+
+/*******************************************************************************
+ * Threads
+ ******************************************************************************/
+
+#define XSTestThread( ... )                             XS::Test::Thread( XS::Test::Thread::Location( __FILE__, __LINE__ ), __VA_ARGS__ )
 
 #endif /* XS_TEST_MACROS_HPP */
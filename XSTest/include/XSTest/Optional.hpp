@@ -162,12 +162,32 @@ namespace XS
                 {
                     using std::swap;
                     
-                    swap( o1._data,     o2._data );
-                    swap( o1._hasValue, o2._hasValue );
+                    if( o1._hasValue && o2._hasValue )
+                    {
+                        swap( o1.Value(), o2.Value() );
+                    }
+                    else if( o1._hasValue )
+                    {
+                        o2.Move( o1 );
+                    }
+                    else if( o2._hasValue )
+                    {
+                        o1.Move( o2 );
+                    }
                 }
                 
             private:
                 
+                void Move( Optional< _T_ > & o )
+                {
+                    new ( this->_data )_T_( std::move( o.Value() ) );
+                    
+                    o.Value().~_T_();
+                    
+                    this->_hasValue = true;
+                    o._hasValue     = false;
+                }
+                
                 alignas( alignof( _T_ ) ) uint8_t _data[ sizeof( _T_ ) ] = {};
                 bool                              _hasValue              = false;
         };
@@ -0,0 +1,704 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Property.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_PROPERTY_HPP
+#define XS_TEST_PROPERTY_HPP
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <random>
+#include <limits>
+#include <type_traits>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstdint>
+#include <XSTest/Assert.hpp>
+#include <XSTest/Collector.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        namespace Property
+        {
+            class Settings
+            {
+                public:
+                    
+                    uint32_t seed   = 0;
+                    size_t   trials = 100;
+                    size_t   jobs   = 1;
+            };
+            
+            inline Settings & SharedSettings()
+            {
+                static Settings settings;
+                
+                return settings;
+            }
+            
+            inline uint32_t GetSeed()
+            {
+                return SharedSettings().seed;
+            }
+            
+            inline void SetSeed( uint32_t seed )
+            {
+                SharedSettings().seed = seed;
+            }
+            
+            inline size_t GetTrials()
+            {
+                return SharedSettings().trials;
+            }
+            
+            inline void SetTrials( size_t trials )
+            {
+                SharedSettings().trials = trials;
+            }
+            
+            inline size_t GetJobs()
+            {
+                return SharedSettings().jobs;
+            }
+            
+            inline void SetJobs( size_t jobs )
+            {
+                SharedSettings().jobs = jobs;
+            }
+            
+            inline uint32_t Mix( uint64_t seed, uint64_t value )
+            {
+                /* SplitMix64, so neighbouring trials get unrelated seeds */
+                uint64_t x( ( seed << 32 ) ^ value );
+                
+                x += 0x9E3779B97F4A7C15ULL;
+                x  = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+                x  = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBULL;
+                x ^= x >> 31;
+                
+                return static_cast< uint32_t >( x ^ ( x >> 32 ) );
+            }
+            
+            template< typename _T_ >
+            class Integer
+            {
+                public:
+                    
+                    typedef _T_ Type;
+                    
+                    Integer():
+                        Integer( std::numeric_limits< _T_ >::min(), std::numeric_limits< _T_ >::max() )
+                    {}
+                    
+                    Integer( _T_ min, _T_ max ):
+                        _min( min ),
+                        _max( max )
+                    {}
+                    
+                    _T_ Generate( std::mt19937 & engine, size_t size ) const
+                    {
+                        _T_ target( this->Target() );
+                        
+                        /* Bounds and small values are more likely to reveal bugs than uniformly distributed ones */
+                        switch( engine() % 8 )
+                        {
+                            case 0:  return this->_min;
+                            case 1:  return this->_max;
+                            case 2:  return target;
+                            case 3:  return this->Uniform( engine, this->Below( target, size ), this->Above( target, size ) );
+                            default: return this->Uniform( engine, this->_min, this->_max );
+                        }
+                    }
+                    
+                    std::vector< _T_ > Shrink( const _T_ & value ) const
+                    {
+                        std::vector< _T_ > values;
+                        _T_                target( this->Target() );
+                        Unsigned           distance( ( value > target ) ? Distance( target, value ) : Distance( value, target ) );
+                        
+                        if( distance == 0 )
+                        {
+                            return values;
+                        }
+                        
+                        values.push_back( target );
+                        
+                        for( Unsigned d = distance / 2; d > 0; d /= 2 )
+                        {
+                            values.push_back( static_cast< _T_ >( ( value > target ) ? static_cast< Wide >( value ) - static_cast< Wide >( d ) : static_cast< Wide >( value ) + static_cast< Wide >( d ) ) );
+                        }
+                        
+                        return values;
+                    }
+                    
+                    std::string Describe( const _T_ & value ) const
+                    {
+                        return std::to_string( static_cast< Wide >( value ) );
+                    }
+                    
+                private:
+                    
+                    typedef typename std::conditional< std::is_signed< _T_ >::value, long long, unsigned long long >::type Wide;
+                    typedef unsigned long long                                                                             Unsigned;
+                    
+                    static Unsigned Distance( _T_ low, _T_ high )
+                    {
+                        return static_cast< Unsigned >( static_cast< Wide >( high ) ) - static_cast< Unsigned >( static_cast< Wide >( low ) );
+                    }
+                    
+                    _T_ Target() const
+                    {
+                        _T_ zero( 0 );
+                        
+                        return ( zero < this->_min ) ? this->_min : ( ( this->_max < zero ) ? this->_max : zero );
+                    }
+                    
+                    _T_ Below( _T_ target, size_t size ) const
+                    {
+                        return ( Distance( this->_min, target ) > size ) ? static_cast< _T_ >( static_cast< Wide >( target ) - static_cast< Wide >( size ) ) : this->_min;
+                    }
+                    
+                    _T_ Above( _T_ target, size_t size ) const
+                    {
+                        return ( Distance( target, this->_max ) > size ) ? static_cast< _T_ >( static_cast< Wide >( target ) + static_cast< Wide >( size ) ) : this->_max;
+                    }
+                    
+                    static _T_ Uniform( std::mt19937 & engine, _T_ min, _T_ max )
+                    {
+                        std::uniform_int_distribution< Wide > distribution( static_cast< Wide >( min ), static_cast< Wide >( max ) );
+                        
+                        return static_cast< _T_ >( distribution( engine ) );
+                    }
+                    
+                    _T_ _min;
+                    _T_ _max;
+            };
+            
+            template< typename _T_ >
+            class Real
+            {
+                public:
+                    
+                    typedef _T_ Type;
+                    
+                    Real():
+                        Real( -std::numeric_limits< _T_ >::max() / 2, std::numeric_limits< _T_ >::max() / 2 )
+                    {}
+                    
+                    Real( _T_ min, _T_ max ):
+                        _min( min ),
+                        _max( max )
+                    {}
+                    
+                    _T_ Generate( std::mt19937 & engine, size_t size ) const
+                    {
+                        _T_ target( this->Target() );
+                        _T_ range( static_cast< _T_ >( size ) );
+                        
+                        switch( engine() % 8 )
+                        {
+                            case 0:  return this->_min;
+                            case 1:  return this->_max;
+                            case 2:  return target;
+                            case 3:  return Uniform( engine, std::max( this->_min, target - range ), std::min( this->_max, target + range ) );
+                            default: return Uniform( engine, this->_min, this->_max );
+                        }
+                    }
+                    
+                    std::vector< _T_ > Shrink( const _T_ & value ) const
+                    {
+                        std::vector< _T_ > values;
+                        _T_                target( this->Target() );
+                        _T_                truncated( std::trunc( value ) );
+                        _T_                half( target + ( value - target ) / 2 );
+                        
+                        if( value == target )
+                        {
+                            return values;
+                        }
+                        
+                        values.push_back( target );
+                        
+                        if( truncated != value && truncated >= this->_min && truncated <= this->_max )
+                        {
+                            values.push_back( truncated );
+                        }
+                        
+                        if( half != value && half != target )
+                        {
+                            values.push_back( half );
+                        }
+                        
+                        return values;
+                    }
+                    
+                    std::string Describe( const _T_ & value ) const
+                    {
+                        std::ostringstream os;
+                        
+                        os.precision( std::numeric_limits< _T_ >::max_digits10 );
+                        
+                        os << value;
+                        
+                        return os.str();
+                    }
+                    
+                private:
+                    
+                    _T_ Target() const
+                    {
+                        return std::min( std::max( static_cast< _T_ >( 0 ), this->_min ), this->_max );
+                    }
+                    
+                    static _T_ Uniform( std::mt19937 & engine, _T_ min, _T_ max )
+                    {
+                        std::uniform_real_distribution< _T_ > distribution( min, max );
+                        
+                        return distribution( engine );
+                    }
+                    
+                    _T_ _min;
+                    _T_ _max;
+            };
+            
+            class String
+            {
+                public:
+                    
+                    typedef std::string Type;
+                    
+                    String():
+                        String( 0 )
+                    {}
+                    
+                    explicit String( size_t maxLength ):
+                        _maxLength( maxLength )
+                    {}
+                    
+                    std::string Generate( std::mt19937 & engine, size_t size ) const
+                    {
+                        size_t      max( ( this->_maxLength > 0 ) ? std::min( size, this->_maxLength ) : size );
+                        size_t      length( engine() % ( max + 1 ) );
+                        std::string s;
+                        
+                        for( size_t i = 0; i < length; i++ )
+                        {
+                            s += static_cast< char >( ' ' + engine() % 95 );
+                        }
+                        
+                        return s;
+                    }
+                    
+                    std::vector< std::string > Shrink( const std::string & value ) const
+                    {
+                        std::vector< std::string > values;
+                        
+                        if( value.length() == 0 )
+                        {
+                            return values;
+                        }
+                        
+                        values.push_back( "" );
+                        
+                        if( value.length() > 1 )
+                        {
+                            values.push_back( value.substr( 0, value.length() / 2 ) );
+                            values.push_back( value.substr( value.length() / 2 ) );
+                        }
+                        
+                        for( size_t i = 0; i < value.length() && value.length() > 1; i++ )
+                        {
+                            values.push_back( value.substr( 0, i ) + value.substr( i + 1 ) );
+                        }
+                        
+                        for( size_t i = 0; i < value.length(); i++ )
+                        {
+                            if( value[ i ] != 'a' )
+                            {
+                                values.push_back( value.substr( 0, i ) + "a" + value.substr( i + 1 ) );
+                                
+                                break;
+                            }
+                        }
+                        
+                        return values;
+                    }
+                    
+                    std::string Describe( const std::string & value ) const
+                    {
+                        std::string s( "\"" );
+                        
+                        for( char c: value )
+                        {
+                            s += ( c == '"' || c == '\\' ) ? std::string( "\\" ) + c : std::string( 1, c );
+                        }
+                        
+                        return s + "\"";
+                    }
+                    
+                private:
+                    
+                    size_t _maxLength;
+            };
+            
+            template< typename _G_ >
+            class Vector
+            {
+                public:
+                    
+                    typedef std::vector< typename _G_::Type > Type;
+                    
+                    Vector():
+                        Vector( _G_() )
+                    {}
+                    
+                    explicit Vector( _G_ element, size_t maxSize = 0 ):
+                        _element( std::move( element ) ),
+                        _maxSize( maxSize )
+                    {}
+                    
+                    Type Generate( std::mt19937 & engine, size_t size ) const
+                    {
+                        size_t max( ( this->_maxSize > 0 ) ? std::min( size, this->_maxSize ) : size );
+                        size_t count( engine() % ( max + 1 ) );
+                        Type   values;
+                        
+                        values.reserve( count );
+                        
+                        for( size_t i = 0; i < count; i++ )
+                        {
+                            values.push_back( this->_element.Generate( engine, size ) );
+                        }
+                        
+                        return values;
+                    }
+                    
+                    std::vector< Type > Shrink( const Type & value ) const
+                    {
+                        std::vector< Type > values;
+                        
+                        if( value.size() == 0 )
+                        {
+                            return values;
+                        }
+                        
+                        values.push_back( Type() );
+                        
+                        if( value.size() > 1 )
+                        {
+                            values.push_back( Type( value.begin(), value.begin() + static_cast< std::ptrdiff_t >( value.size() / 2 ) ) );
+                            values.push_back( Type( value.begin() + static_cast< std::ptrdiff_t >( value.size() / 2 ), value.end() ) );
+                        }
+                        
+                        for( size_t i = 0; i < value.size() && value.size() > 1; i++ )
+                        {
+                            Type v( value );
+                            
+                            v.erase( v.begin() + static_cast< std::ptrdiff_t >( i ) );
+                            values.push_back( std::move( v ) );
+                        }
+                        
+                        for( size_t i = 0; i < value.size(); i++ )
+                        {
+                            for( const auto & element: this->_element.Shrink( value[ i ] ) )
+                            {
+                                Type v( value );
+                                
+                                v[ i ] = element;
+                                
+                                values.push_back( std::move( v ) );
+                            }
+                        }
+                        
+                        return values;
+                    }
+                    
+                    std::string Describe( const Type & value ) const
+                    {
+                        std::string s( "[" );
+                        
+                        for( size_t i = 0; i < value.size(); i++ )
+                        {
+                            s += ( ( i > 0 ) ? ", " : "" ) + this->_element.Describe( value[ i ] );
+                        }
+                        
+                        return s + "]";
+                    }
+                    
+                private:
+                    
+                    _G_    _element;
+                    size_t _maxSize;
+            };
+            
+            template< typename ... _G_ >
+            std::tuple< _G_ ... > ForAll( _G_ ... generators )
+            {
+                return std::tuple< _G_ ... >( std::move( generators ) ... );
+            }
+            
+            template< size_t ... _I_ >
+            class Indices
+            {};
+            
+            template< size_t _N_, size_t ... _I_ >
+            class MakeIndices: public MakeIndices< _N_ - 1, _N_ - 1, _I_ ... >
+            {};
+            
+            template< size_t ... _I_ >
+            class MakeIndices< 0, _I_ ... >
+            {
+                public:
+                    
+                    typedef Indices< _I_ ... > Type;
+            };
+            
+            template< typename _F_, typename ... _G_ >
+            class Checker
+            {
+                public:
+                    
+                    typedef std::tuple< typename _G_::Type ... > Values;
+                    
+                    Checker( _F_ property, std::tuple< _G_ ... > generators, uint32_t seed, size_t trials, size_t jobs ):
+                        _property(   std::move( property ) ),
+                        _generators( std::move( generators ) ),
+                        _seed(       seed ),
+                        _trials(     trials ),
+                        _jobs(       std::max< size_t >( jobs, 1 ) )
+                    {}
+                    
+                    bool Run( Values & counterexample, size_t & trials, size_t & shrinks ) const
+                    {
+                        size_t first( this->FirstFailing( this->_trials, [ this ]( size_t i ) { return this->Holds( this->Generate( i ) ); } ) );
+                        
+                        trials  = std::min( first + 1, this->_trials );
+                        shrinks = 0;
+                        
+                        if( first == this->_trials )
+                        {
+                            return true;
+                        }
+                        
+                        counterexample = this->Generate( first );
+                        
+                        /* Shrinking stops when no smaller input fails, or after a fixed number of steps if shrinking doesn't converge */
+                        while( shrinks < 1000 )
+                        {
+                            std::vector< Values > candidates( this->Shrink( counterexample, typename MakeIndices< sizeof ... ( _G_ ) >::Type() ) );
+                            size_t                index( this->FirstFailing( candidates.size(), [ & ]( size_t i ) { return this->Holds( candidates[ i ] ); } ) );
+                            
+                            if( index == candidates.size() )
+                            {
+                                break;
+                            }
+                            
+                            counterexample = candidates[ index ];
+                            
+                            shrinks++;
+                        }
+                        
+                        return false;
+                    }
+                    
+                    std::string Describe( const Values & values ) const
+                    {
+                        return "(" + this->Describe( values, typename MakeIndices< sizeof ... ( _G_ ) >::Type() ) + ")";
+                    }
+                    
+                private:
+                    
+                    Values Generate( size_t trial ) const
+                    {
+                        std::mt19937 engine( Mix( this->_seed, trial ) );
+                        
+                        /* Inputs start small and grow with the trials, so simple counterexamples are found first */
+                        return this->Generate( engine, 1 + ( trial * 100 ) / this->_trials, typename MakeIndices< sizeof ... ( _G_ ) >::Type() );
+                    }
+                    
+                    template< size_t ... _I_ >
+                    Values Generate( std::mt19937 & engine, size_t size, Indices< _I_ ... > ) const
+                    {
+                        return Values{ std::get< _I_ >( this->_generators ).Generate( engine, size ) ... };
+                    }
+                    
+                    template< size_t ... _I_ >
+                    std::vector< Values > Shrink( const Values & values, Indices< _I_ ... > ) const
+                    {
+                        std::vector< Values > candidates;
+                        int                   expand[] = { 0, ( this->Shrink< _I_ >( values, candidates ), 0 ) ... };
+                        
+                        static_cast< void >( expand );
+                        
+                        return candidates;
+                    }
+                    
+                    template< size_t _I_ >
+                    void Shrink( const Values & values, std::vector< Values > & candidates ) const
+                    {
+                        for( const auto & value: std::get< _I_ >( this->_generators ).Shrink( std::get< _I_ >( values ) ) )
+                        {
+                            Values candidate( values );
+                            
+                            std::get< _I_ >( candidate ) = value;
+                            
+                            candidates.push_back( std::move( candidate ) );
+                        }
+                    }
+                    
+                    template< size_t ... _I_ >
+                    std::string Describe( const Values & values, Indices< _I_ ... > ) const
+                    {
+                        std::string s;
+                        int         expand[] = { 0, ( s += ( ( _I_ > 0 ) ? ", " : "" ) + std::get< _I_ >( this->_generators ).Describe( std::get< _I_ >( values ) ), 0 ) ... };
+                        
+                        static_cast< void >( expand );
+                        
+                        return s;
+                    }
+                    
+                    bool Holds( const Values & values ) const
+                    {
+                        Collector        collector;
+                        Collector::Scope scope( collector );
+                        
+                        /* Assertions in the property are collected here, so they falsify it instead of failing the test case */
+                        try
+                        {
+                            if( this->Call( values, typename MakeIndices< sizeof ... ( _G_ ) >::Type() ) == false )
+                            {
+                                return false;
+                            }
+                        }
+                        catch( ... )
+                        {
+                            return false;
+                        }
+                        
+                        return collector.GetCount() == 0;
+                    }
+                    
+                    template< size_t ... _I_ >
+                    bool Call( const Values & values, Indices< _I_ ... > ) const
+                    {
+                        return this->Invoke( std::is_void< decltype( std::declval< const _F_ & >()( std::get< _I_ >( values ) ... ) ) >(), std::get< _I_ >( values ) ... );
+                    }
+                    
+                    template< typename ... _A_ >
+                    bool Invoke( std::true_type, const _A_ & ... args ) const
+                    {
+                        this->_property( args ... );
+                        
+                        return true;
+                    }
+                    
+                    template< typename ... _A_ >
+                    bool Invoke( std::false_type, const _A_ & ... args ) const
+                    {
+                        return static_cast< bool >( this->_property( args ... ) );
+                    }
+                    
+                    size_t FirstFailing( size_t count, const std::function< bool( size_t ) > & holds ) const
+                    {
+                        std::atomic< size_t >       first( count );
+                        std::vector< std::thread > threads;
+                        size_t                      jobs( std::min( this->_jobs, count ) );
+                        
+                        auto work = [ & ]( size_t job )
+                        {
+                            /* Indices past an already failing one can be skipped, as the lowest failing index is kept */
+                            for( size_t i = job; i < count && i < first.load(); i += jobs )
+                            {
+                                if( holds( i ) == false )
+                                {
+                                    size_t current( first.load() );
+                                    
+                                    while( i < current && first.compare_exchange_weak( current, i ) == false )
+                                    {}
+                                }
+                            }
+                        };
+                        
+                        for( size_t i = 1; i < jobs; i++ )
+                        {
+                            threads.push_back( std::thread( work, i ) );
+                        }
+                        
+                        work( 0 );
+                        
+                        for( auto & thread: threads )
+                        {
+                            thread.join();
+                        }
+                        
+                        return first.load();
+                    }
+                    
+                    _F_                   _property;
+                    std::tuple< _G_ ... > _generators;
+                    uint32_t              _seed;
+                    size_t                _trials;
+                    size_t                _jobs;
+            };
+            
+            template< typename _F_, typename ... _G_ >
+            inline void Check( std::tuple< _G_ ... > generators, _F_ property, const char * expression, const char * file, size_t line, bool fatal = true )
+            {
+                /* Each assertion gets its own seed, derived from the run seed, so it doesn't depend on the order of the test cases */
+                uint32_t                                 seed( Mix( GetSeed(), std::hash< std::string >()( std::string( file ) + ":" + std::to_string( line ) ) ) );
+                Checker< _F_, _G_ ... >                  checker( std::move( property ), std::move( generators ), seed, std::max< size_t >( GetTrials(), 1 ), GetJobs() );
+                typename Checker< _F_, _G_ ... >::Values counterexample;
+                size_t                                   trials;
+                size_t                                   shrinks;
+                
+                if( checker.Run( counterexample, trials, shrinks ) == false )
+                {
+                    Assert::Fail
+                    (
+                        fatal,
+                        expression,
+                        "Holds for " + Utility::Numbered( "trial", std::max< size_t >( GetTrials(), 1 ) ),
+                        "Falsified by " + checker.Describe( counterexample ) + " after " + Utility::Numbered( "trial", trials ) + " and " + Utility::Numbered( "shrink", shrinks ) + " (replay with --seed=" + std::to_string( GetSeed() ) + ")",
+                        file,
+                        line
+                    );
+                }
+            }
+        }
+    }
+}
+
+#endif /* XS_TEST_PROPERTY_HPP */
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Registration.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_REGISTRATION_HPP
+#define XS_TEST_REGISTRATION_HPP
+
+#include <cstddef>
+
+#define XS_TEST_GET_REGISTRY_DECLARATION                                    \
+    Registry & GetRegistry();
+
+#define XS_TEST_GET_REGISTRY_DEFINITION                                     \
+    Registry & GetRegistry()                                                \
+    {                                                                       \
+        static Registry registry;                                           \
+                                                                            \
+        return registry;                                                    \
+    }
+
+namespace XS
+{
+    namespace Test
+    {
+        class Case;
+        class Registrar;
+        
+        class Registration
+        {
+            public:
+                
+                constexpr Registration( const char * suiteName, const char * caseName, Case * ( * create )(), const char * file, size_t line, void ( * setUpTestSuite )() = nullptr, void ( * tearDownTestSuite )() = nullptr, size_t ( * parameters )() = nullptr, const char * typeName = nullptr ) noexcept:
+                    _suiteName(         suiteName ),
+                    _caseName(          caseName ),
+                    _create(            create ),
+                    _file(              file ),
+                    _line(              line ),
+                    _setUpTestSuite(    setUpTestSuite ),
+                    _tearDownTestSuite( tearDownTestSuite ),
+                    _parameters(        parameters ),
+                    _typeName(          typeName ),
+                    _next(              nullptr )
+                {}
+                
+                Registration( const Registration & o )              = delete;
+                Registration & operator =( const Registration & o ) = delete;
+                
+                const char * GetSuiteName() const noexcept
+                {
+                    return this->_suiteName;
+                }
+                
+                const char * GetCaseName() const noexcept
+                {
+                    return this->_caseName;
+                }
+                
+                const char * GetFile() const noexcept
+                {
+                    return this->_file;
+                }
+                
+                size_t GetLine() const noexcept
+                {
+                    return this->_line;
+                }
+                
+                auto GetSetUpTestSuite() const noexcept -> void ( * )()
+                {
+                    return this->_setUpTestSuite;
+                }
+                
+                auto GetTearDownTestSuite() const noexcept -> void ( * )()
+                {
+                    return this->_tearDownTestSuite;
+                }
+                
+                bool IsParameterized() const noexcept
+                {
+                    return this->_parameters != nullptr;
+                }
+                
+                size_t GetParameterCount() const
+                {
+                    return ( this->_parameters == nullptr ) ? 0 : this->_parameters();
+                }
+                
+                const char * GetTypeName() const noexcept
+                {
+                    return this->_typeName;
+                }
+                
+                const Registration * GetNext() const noexcept
+                {
+                    return this->_next;
+                }
+                
+                Case * Create() const
+                {
+                    return this->_create();
+                }
+                
+            private:
+                
+                friend class Registrar;
+                
+                const char *   _suiteName;
+                const char *   _caseName;
+                Case * ( *     _create )();
+                const char *   _file;
+                size_t         _line;
+                void ( *       _setUpTestSuite )();
+                void ( *       _tearDownTestSuite )();
+                size_t ( *     _parameters )();
+                const char *   _typeName;
+                Registration * _next;
+        };
+        
+        class Registry
+        {
+            public:
+                
+                constexpr Registry() noexcept:
+                    _first( nullptr ),
+                    _last(  nullptr ),
+                    _count( 0 )
+                {}
+                
+                Registry( const Registry & o )              = delete;
+                Registry & operator =( const Registry & o ) = delete;
+                
+                const Registration * GetFirst() const noexcept
+                {
+                    return this->_first;
+                }
+                
+                size_t GetCount() const noexcept
+                {
+                    return this->_count;
+                }
+                
+            private:
+                
+                friend class Registrar;
+                
+                Registration * _first;
+                Registration * _last;
+                size_t         _count;
+        };
+        
+        #if defined( XSTEST_MAIN ) || defined( XSTEST_MAIN_RUN )
+        
+        inline XS_TEST_GET_REGISTRY_DEFINITION
+        
+        #else
+        
+        extern XS_TEST_GET_REGISTRY_DECLARATION
+        
+        #endif
+        
+        class Registrar
+        {
+            public:
+                
+                Registrar( Registration & registration ) noexcept
+                {
+                    Registry & registry( GetRegistry() );
+                    
+                    if( registry._last == nullptr )
+                    {
+                        registry._first = &registration;
+                    }
+                    else
+                    {
+                        registry._last->_next = &registration;
+                    }
+                    
+                    registry._last = &registration;
+                    
+                    registry._count++;
+                }
+                
+                Registrar( const Registrar & o )              = delete;
+                Registrar & operator =( const Registrar & o ) = delete;
+        };
+    }
+}
+
+#endif /* XS_TEST_REGISTRATION_HPP */
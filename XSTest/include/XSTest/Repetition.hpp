@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Repetition.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_REPETITION_HPP
+#define XS_TEST_REPETITION_HPP
+
+#include <algorithm>
+#include <XSTest/Statistics.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Repetition
+        {
+            public:
+                
+                Repetition():
+                    Repetition( 0, 0, Statistics() )
+                {}
+                
+                Repetition( size_t runs, size_t failedRuns, Statistics durations ):
+                    _runs(       runs ),
+                    _failedRuns( failedRuns ),
+                    _durations(  std::move( durations ) )
+                {}
+                
+                Repetition( const Repetition & o ):
+                    _runs(       o._runs ),
+                    _failedRuns( o._failedRuns ),
+                    _durations(  o._durations )
+                {}
+                
+                Repetition( Repetition && o ) noexcept:
+                    _runs(       std::move( o._runs ) ),
+                    _failedRuns( std::move( o._failedRuns ) ),
+                    _durations(  std::move( o._durations ) )
+                {}
+                
+                ~Repetition()
+                {}
+                
+                Repetition & operator =( Repetition o )
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                size_t GetRuns() const noexcept
+                {
+                    return this->_runs;
+                }
+                
+                size_t GetFailedRuns() const noexcept
+                {
+                    return this->_failedRuns;
+                }
+                
+                size_t GetPassedRuns() const noexcept
+                {
+                    return this->_runs - this->_failedRuns;
+                }
+                
+                const Statistics & GetDurations() const noexcept
+                {
+                    return this->_durations;
+                }
+                
+                friend void swap( Repetition & o1, Repetition & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._runs,       o2._runs );
+                    swap( o1._failedRuns, o2._failedRuns );
+                    swap( o1._durations,  o2._durations );
+                }
+                
+            private:
+                
+                size_t     _runs;
+                size_t     _failedRuns;
+                Statistics _durations;
+        };
+    }
+}
+
+#endif /* XS_TEST_REPETITION_HPP */
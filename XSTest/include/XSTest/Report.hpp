@@ -0,0 +1,468 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Report.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_REPORT_HPP
+#define XS_TEST_REPORT_HPP
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+#include <XSTest/Optional.hpp>
+#include <XSTest/Failure.hpp>
+#include <XSTest/Benchmark.hpp>
+#include <XSTest/Allocations.hpp>
+#include <XSTest/Repetition.hpp>
+#include <XSTest/ResourceUsage.hpp>
+#include <XSTest/Info.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Report
+        {
+            public:
+                
+                enum class Format
+                {
+                    JUnit,
+                    JSON
+                };
+                
+                Report( Format format, const std::string & path ):
+                    _format(     format ),
+                    _path(       path ),
+                    _stream(     path, std::ios::out | std::ios::trunc ),
+                    _closed(     false ),
+                    _start(      std::chrono::steady_clock::now() ),
+                    _attributes( 0 ),
+                    _tests(      0 ),
+                    _failures(   0 ),
+                    _errors(     0 )
+                {
+                    if( this->_format == Format::JUnit )
+                    {
+                        this->_stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                      << "<testsuites>\n"
+                                      << "    <testsuite name=\"XSTest\"";
+                        
+                        this->_attributes = this->_stream.tellp();
+                        
+                        this->_stream << this->Attributes() << ">\n";
+                    }
+                    
+                    this->_stream.flush();
+                }
+                
+                ~Report()
+                {
+                    this->Close();
+                }
+                
+                Report( const Report & o )              = delete;
+                Report & operator =( const Report & o ) = delete;
+                
+                Format GetFormat() const noexcept
+                {
+                    return this->_format;
+                }
+                
+                std::string GetPath() const
+                {
+                    return this->_path;
+                }
+                
+                bool IsGood() const
+                {
+                    return this->_stream.good();
+                }
+                
+                void Add( const Info & info )
+                {
+                    std::string record( ( this->_format == Format::JUnit ) ? JUnit( info ) : JSON( info ) );
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        
+                        if( this->_closed )
+                        {
+                            return;
+                        }
+                        
+                        this->_tests++;
+                        
+                        if( info.GetStatus() == Info::Status::TimedOut )
+                        {
+                            this->_errors++;
+                        }
+                        else if( info.GetStatus() != Info::Status::Success )
+                        {
+                            this->_failures++;
+                        }
+                        
+                        /* Each record is flushed, so the report stays usable if the process dies */
+                        this->_stream << record;
+                        this->_stream.flush();
+                    }
+                }
+                
+                void Close()
+                {
+                    std::lock_guard< std::mutex > l( this->_mutex );
+                    
+                    if( this->_closed )
+                    {
+                        return;
+                    }
+                    
+                    if( this->_format == Format::JUnit )
+                    {
+                        std::streampos end( this->_stream.tellp() );
+                        
+                        /* Counts are only known at the end, and overwrite the space reserved for them in the opening tag */
+                        this->_stream.seekp( this->_attributes );
+                        this->_stream << this->Attributes();
+                        this->_stream.seekp( end );
+                        
+                        this->_stream << "    </testsuite>\n"
+                                      << "</testsuites>\n";
+                    }
+                    
+                    this->_stream.flush();
+                    
+                    this->_closed = true;
+                }
+                
+            private:
+                
+                std::string Attributes() const
+                {
+                    std::ostringstream attributes;
+                    
+                    attributes << " tests=\""
+                               << this->_tests
+                               << "\" failures=\""
+                               << this->_failures
+                               << "\" errors=\""
+                               << this->_errors
+                               << "\" time=\""
+                               << Seconds( std::chrono::steady_clock::now() - this->_start )
+                               << "\"";
+                    
+                    /* Whitespace is allowed before the end of the tag, so the attributes always have the same length */
+                    return attributes.str() + std::string( ( attributes.str().length() < 96 ) ? 96 - attributes.str().length() : 0, ' ' );
+                }
+                
+                static std::string JUnit( const Info & info )
+                {
+                    std::ostringstream record;
+                    
+                    record << "        <testcase classname=\""
+                           << EscapeXML( info.GetSuiteName() )
+                           << "\" name=\""
+                           << EscapeXML( info.GetCaseName() )
+                           << "\" file=\""
+                           << EscapeXML( info.GetFile() )
+                           << "\" line=\""
+                           << info.GetLine()
+                           << "\" time=\""
+                           << Seconds( info.GetDuration() )
+                           << "\"";
+                    
+                    if( info.GetFailures().size() == 0 )
+                    {
+                        record << "/>\n";
+                        
+                        return record.str();
+                    }
+                    
+                    record << ">\n";
+                    
+                    /* Timed out test cases are counted as errors, so they are also written as errors */
+                    for( const auto & failure: info.GetFailures() )
+                    {
+                        const char * element( ( info.GetStatus() == Info::Status::TimedOut ) ? "error" : "failure" );
+                        
+                        record << "            <"
+                               << element
+                               << " message=\""
+                               << EscapeXML( failure.GetDescription() )
+                               << "\" type=\""
+                               << ( ( info.GetStatus() == Info::Status::TimedOut ) ? "timeout" : "failure" )
+                               << "\">"
+                               << EscapeXML( File( failure, info ) )
+                               << ":"
+                               << Line( failure, info )
+                               << "</"
+                               << element
+                               << ">\n";
+                    }
+                    
+                    record << "        </testcase>\n";
+                    
+                    return record.str();
+                }
+                
+                static std::string JSON( const Info & info )
+                {
+                    std::ostringstream        record;
+                    Optional< Failure >       failure( info.GetFailure() );
+                    Optional< Benchmark >     benchmark( info.GetBenchmark() );
+                    Optional< Allocations >   allocations( info.GetAllocations() );
+                    Optional< ResourceUsage > resources( info.GetResourceUsage() );
+                    Optional< Repetition >    repetition( info.GetRepetition() );
+                    
+                    record << "{\"suite\":"
+                           << EscapeJSON( info.GetSuiteName() )
+                           << ",\"case\":"
+                           << EscapeJSON( info.GetCaseName() )
+                           << ",\"file\":"
+                           << EscapeJSON( info.GetFile() )
+                           << ",\"line\":"
+                           << info.GetLine()
+                           << ",\"status\":"
+                           << ( ( info.GetStatus() == Info::Status::Success ) ? "\"passed\"" : ( ( info.GetStatus() == Info::Status::TimedOut ) ? "\"timedout\"" : "\"failed\"" ) )
+                           << ",\"duration\":"
+                           << info.GetDuration().count()
+                           << ",\"threadCPUTime\":"
+                           << info.GetThreadCPUTime().count()
+                           << ",\"processCPUTime\":"
+                           << info.GetProcessCPUTime().count();
+                    
+                    if( failure.HasValue() )
+                    {
+                        record << ",\"failure\":"
+                               << JSON( failure.Value(), info );
+                    }
+                    
+                    if( info.GetFailures().size() > 0 )
+                    {
+                        record << ",\"failures\":[";
+                        
+                        for( size_t i = 0; i < info.GetFailures().size(); i++ )
+                        {
+                            record << ( ( i > 0 ) ? "," : "" )
+                                   << JSON( info.GetFailures()[ i ], info );
+                        }
+                        
+                        record << "]";
+                    }
+                    
+                    if( resources.HasValue() )
+                    {
+                        record << ",\"resourceUsage\":{\"userTime\":"
+                               << std::chrono::duration_cast< std::chrono::nanoseconds >( resources->GetUserTime() ).count()
+                               << ",\"systemTime\":"
+                               << std::chrono::duration_cast< std::chrono::nanoseconds >( resources->GetSystemTime() ).count()
+                               << ",\"maxRSS\":"
+                               << resources->GetMaxRSS()
+                               << ",\"minorFaults\":"
+                               << resources->GetMinorFaults()
+                               << ",\"majorFaults\":"
+                               << resources->GetMajorFaults()
+                               << ",\"voluntarySwitches\":"
+                               << resources->GetVoluntarySwitches()
+                               << ",\"involuntarySwitches\":"
+                               << resources->GetInvoluntarySwitches()
+                               << "}";
+                    }
+                    
+                    if( allocations.HasValue() )
+                    {
+                        record << ",\"allocations\":{\"count\":"
+                               << allocations->GetCount()
+                               << ",\"bytes\":"
+                               << allocations->GetBytes()
+                               << ",\"peak\":"
+                               << allocations->GetPeak()
+                               << "}";
+                    }
+                    
+                    if( benchmark.HasValue() )
+                    {
+                        record << ",\"benchmark\":{\"iterations\":"
+                               << benchmark->GetIterations()
+                               << ",\"mean\":"
+                               << benchmark->GetStatistics().GetMean()
+                               << ",\"median\":"
+                               << benchmark->GetStatistics().GetMedian()
+                               << ",\"standardDeviation\":"
+                               << benchmark->GetStatistics().GetStandardDeviation()
+                               << ",\"min\":"
+                               << benchmark->GetStatistics().GetMin()
+                               << ",\"max\":"
+                               << benchmark->GetStatistics().GetMax()
+                               << "}";
+                    }
+                    
+                    if( repetition.HasValue() )
+                    {
+                        record << ",\"repetition\":{\"runs\":"
+                               << repetition->GetRuns()
+                               << ",\"failedRuns\":"
+                               << repetition->GetFailedRuns()
+                               << ",\"mean\":"
+                               << repetition->GetDurations().GetMean()
+                               << ",\"median\":"
+                               << repetition->GetDurations().GetMedian()
+                               << ",\"standardDeviation\":"
+                               << repetition->GetDurations().GetStandardDeviation()
+                               << ",\"min\":"
+                               << repetition->GetDurations().GetMin()
+                               << ",\"max\":"
+                               << repetition->GetDurations().GetMax()
+                               << "}";
+                    }
+                    
+                    record << "}\n";
+                    
+                    return record.str();
+                }
+                
+                static std::string JSON( const Failure & failure, const Info & info )
+                {
+                    std::ostringstream record;
+                    
+                    record << "{\"description\":"
+                           << EscapeJSON( failure.GetDescription() )
+                           << ",\"file\":"
+                           << EscapeJSON( File( failure, info ) )
+                           << ",\"line\":"
+                           << Line( failure, info )
+                           << "}";
+                    
+                    return record.str();
+                }
+                
+                /* Failures without a location, like crashes or exceptions from threads, are reported at the test case */
+                static std::string File( const Failure & failure, const Info & info )
+                {
+                    return ( failure.GetFile().length() > 0 ) ? failure.GetFile() : info.GetFile();
+                }
+                
+                static size_t Line( const Failure & failure, const Info & info )
+                {
+                    return ( failure.GetFile().length() > 0 ) ? failure.GetLine() : info.GetLine();
+                }
+                
+                static std::string Seconds( std::chrono::nanoseconds duration )
+                {
+                    char buffer[ 64 ];
+                    
+                    snprintf( buffer, sizeof( buffer ), "%.6f", static_cast< double >( duration.count() ) / 1e9 );
+                    
+                    return buffer;
+                }
+                
+                static std::string EscapeXML( const std::string & s )
+                {
+                    std::string escaped;
+                    
+                    escaped.reserve( s.length() );
+                    
+                    for( char c: s )
+                    {
+                        switch( c )
+                        {
+                            case '&':  escaped += "&amp;";  break;
+                            case '<':  escaped += "&lt;";   break;
+                            case '>':  escaped += "&gt;";   break;
+                            case '"':  escaped += "&quot;"; break;
+                            case '\'': escaped += "&apos;"; break;
+                            case '\n': escaped += "&#10;";  break;
+                            case '\t': escaped += "&#9;";   break;
+                            
+                            default:
+                                
+                                /* Other control characters are not allowed in XML 1.0 */
+                                if( static_cast< unsigned char >( c ) >= 0x20 || c == '\r' )
+                                {
+                                    escaped += c;
+                                }
+                        }
+                    }
+                    
+                    return escaped;
+                }
+                
+                static std::string EscapeJSON( const std::string & s )
+                {
+                    std::string escaped( "\"" );
+                    
+                    escaped.reserve( s.length() + 2 );
+                    
+                    for( char c: s )
+                    {
+                        switch( c )
+                        {
+                            case '"':  escaped += "\\\""; break;
+                            case '\\': escaped += "\\\\"; break;
+                            case '\n': escaped += "\\n";  break;
+                            case '\r': escaped += "\\r";  break;
+                            case '\t': escaped += "\\t";  break;
+                            
+                            default:
+                                
+                                if( static_cast< unsigned char >( c ) < 0x20 )
+                                {
+                                    char buffer[ 8 ];
+                                    
+                                    snprintf( buffer, sizeof( buffer ), "\\u%04x", static_cast< unsigned int >( c ) );
+                                    
+                                    escaped += buffer;
+                                }
+                                else
+                                {
+                                    escaped += c;
+                                }
+                        }
+                    }
+                    
+                    return escaped + "\"";
+                }
+                
+                Format                                _format;
+                std::string                           _path;
+                std::ofstream                         _stream;
+                bool                                  _closed;
+                std::mutex                            _mutex;
+                std::chrono::steady_clock::time_point _start;
+                std::streampos                        _attributes;
+                size_t                                _tests;
+                size_t                                _failures;
+                size_t                                _errors;
+        };
+    }
+}
+
+#endif /* XS_TEST_REPORT_HPP */
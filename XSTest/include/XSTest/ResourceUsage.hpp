@@ -0,0 +1,240 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ResourceUsage.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_RESOURCE_USAGE_HPP
+#define XS_TEST_RESOURCE_USAGE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+namespace XS
+{
+    namespace Test
+    {
+        class ResourceUsage
+        {
+            public:
+                
+                ResourceUsage():
+                    ResourceUsage( std::chrono::microseconds( 0 ), std::chrono::microseconds( 0 ), 0, 0, 0, 0, 0 )
+                {}
+                
+                ResourceUsage( std::chrono::microseconds userTime, std::chrono::microseconds systemTime, uint64_t maxRSS, uint64_t minorFaults, uint64_t majorFaults, uint64_t voluntarySwitches, uint64_t involuntarySwitches ):
+                    _userTime(            userTime ),
+                    _systemTime(          systemTime ),
+                    _maxRSS(              maxRSS ),
+                    _minorFaults(         minorFaults ),
+                    _majorFaults(         majorFaults ),
+                    _voluntarySwitches(   voluntarySwitches ),
+                    _involuntarySwitches( involuntarySwitches )
+                {}
+                
+                ResourceUsage( const ResourceUsage & o ):
+                    _userTime(            o._userTime ),
+                    _systemTime(          o._systemTime ),
+                    _maxRSS(              o._maxRSS ),
+                    _minorFaults(         o._minorFaults ),
+                    _majorFaults(         o._majorFaults ),
+                    _voluntarySwitches(   o._voluntarySwitches ),
+                    _involuntarySwitches( o._involuntarySwitches )
+                {}
+                
+                ResourceUsage( ResourceUsage && o ) noexcept:
+                    _userTime(            std::move( o._userTime ) ),
+                    _systemTime(          std::move( o._systemTime ) ),
+                    _maxRSS(              std::move( o._maxRSS ) ),
+                    _minorFaults(         std::move( o._minorFaults ) ),
+                    _majorFaults(         std::move( o._majorFaults ) ),
+                    _voluntarySwitches(   std::move( o._voluntarySwitches ) ),
+                    _involuntarySwitches( std::move( o._involuntarySwitches ) )
+                {}
+                
+                ~ResourceUsage()
+                {}
+                
+                ResourceUsage & operator =( ResourceUsage o )
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                static ResourceUsage Current()
+                {
+                    ResourceUsage usage;
+                    
+                    #ifdef _WIN32
+                    
+                    FILETIME creation;
+                    FILETIME exit;
+                    FILETIME kernel;
+                    FILETIME user;
+                    
+                    /* Only CPU times are available on Windows */
+                    if( GetThreadTimes( GetCurrentThread(), &creation, &exit, &kernel, &user ) != FALSE )
+                    {
+                        usage._userTime   = FromFileTime( user );
+                        usage._systemTime = FromFileTime( kernel );
+                    }
+                    
+                    #else
+                    
+                    struct rusage r;
+                    
+                    #ifdef RUSAGE_THREAD
+                    int who( RUSAGE_THREAD );
+                    #else
+                    int who( RUSAGE_SELF );
+                    #endif
+                    
+                    if( getrusage( who, &r ) != 0 )
+                    {
+                        return usage;
+                    }
+                    
+                    usage._userTime            = std::chrono::seconds( r.ru_utime.tv_sec ) + std::chrono::microseconds( r.ru_utime.tv_usec );
+                    usage._systemTime          = std::chrono::seconds( r.ru_stime.tv_sec ) + std::chrono::microseconds( r.ru_stime.tv_usec );
+                    usage._minorFaults         = static_cast< uint64_t >( r.ru_minflt );
+                    usage._majorFaults         = static_cast< uint64_t >( r.ru_majflt );
+                    usage._voluntarySwitches   = static_cast< uint64_t >( r.ru_nvcsw );
+                    usage._involuntarySwitches = static_cast< uint64_t >( r.ru_nivcsw );
+                    
+                    #ifdef __APPLE__
+                    usage._maxRSS = static_cast< uint64_t >( r.ru_maxrss );
+                    #else
+                    usage._maxRSS = static_cast< uint64_t >( r.ru_maxrss ) * 1024;
+                    #endif
+                    
+                    #endif
+                    
+                    return usage;
+                }
+                
+                ResourceUsage operator -( const ResourceUsage & o ) const
+                {
+                    ResourceUsage usage;
+                    
+                    usage._userTime            = this->_userTime   - o._userTime;
+                    usage._systemTime          = this->_systemTime - o._systemTime;
+                    usage._maxRSS              = Difference( this->_maxRSS,              o._maxRSS );
+                    usage._minorFaults         = Difference( this->_minorFaults,         o._minorFaults );
+                    usage._majorFaults         = Difference( this->_majorFaults,         o._majorFaults );
+                    usage._voluntarySwitches   = Difference( this->_voluntarySwitches,   o._voluntarySwitches );
+                    usage._involuntarySwitches = Difference( this->_involuntarySwitches, o._involuntarySwitches );
+                    
+                    return usage;
+                }
+                
+                std::chrono::microseconds GetUserTime() const noexcept
+                {
+                    return this->_userTime;
+                }
+                
+                std::chrono::microseconds GetSystemTime() const noexcept
+                {
+                    return this->_systemTime;
+                }
+                
+                uint64_t GetMaxRSS() const noexcept
+                {
+                    return this->_maxRSS;
+                }
+                
+                uint64_t GetMinorFaults() const noexcept
+                {
+                    return this->_minorFaults;
+                }
+                
+                uint64_t GetMajorFaults() const noexcept
+                {
+                    return this->_majorFaults;
+                }
+                
+                uint64_t GetVoluntarySwitches() const noexcept
+                {
+                    return this->_voluntarySwitches;
+                }
+                
+                uint64_t GetInvoluntarySwitches() const noexcept
+                {
+                    return this->_involuntarySwitches;
+                }
+                
+                friend void swap( ResourceUsage & o1, ResourceUsage & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._userTime,            o2._userTime );
+                    swap( o1._systemTime,          o2._systemTime );
+                    swap( o1._maxRSS,              o2._maxRSS );
+                    swap( o1._minorFaults,         o2._minorFaults );
+                    swap( o1._majorFaults,         o2._majorFaults );
+                    swap( o1._voluntarySwitches,   o2._voluntarySwitches );
+                    swap( o1._involuntarySwitches, o2._involuntarySwitches );
+                }
+                
+            private:
+                
+                static uint64_t Difference( uint64_t v1, uint64_t v2 ) noexcept
+                {
+                    return ( v1 > v2 ) ? v1 - v2 : 0;
+                }
+                
+                #ifdef _WIN32
+                
+                static std::chrono::microseconds FromFileTime( const FILETIME & time )
+                {
+                    uint64_t ticks( ( static_cast< uint64_t >( time.dwHighDateTime ) << 32 ) | time.dwLowDateTime );
+                    
+                    return std::chrono::microseconds( static_cast< int64_t >( ticks / 10 ) );
+                }
+                
+                #endif
+                
+                std::chrono::microseconds _userTime;
+                std::chrono::microseconds _systemTime;
+                uint64_t                  _maxRSS;
+                uint64_t                  _minorFaults;
+                uint64_t                  _majorFaults;
+                uint64_t                  _voluntarySwitches;
+                uint64_t                  _involuntarySwitches;
+        };
+    }
+}
+
+#endif /* XS_TEST_RESOURCE_USAGE_HPP */
@@ -34,6 +34,14 @@
 #include <iostream>
 #include <memory>
 #include <algorithm>
+#include <mutex>
+#include <functional>
+#include <utility>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <sstream>
 #include <XSTest/Optional.hpp>
 #include <XSTest/Utility.hpp>
 #include <XSTest/Info.hpp>
@@ -41,6 +49,14 @@
 #include <XSTest/StopWatch.hpp>
 #include <XSTest/Logging.hpp>
 #include <XSTest/TermColor.hpp>
+#include <XSTest/Arguments.hpp>
+#include <XSTest/ThreadPool.hpp>
+#include <XSTest/History.hpp>
+#include <XSTest/Isolation.hpp>
+#include <XSTest/Report.hpp>
+#include <XSTest/Watchdog.hpp>
+#include <XSTest/Environment.hpp>
+#include <XSTest/Property.hpp>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -56,18 +72,77 @@ namespace XS
         {
             public:
                 
-                Runner( const std::vector< Suite > & suites ):
-                    _suites( suites )
-                {
-                    Utility::Shuffle( this->_suites );
-                }
+                Runner( std::vector< Suite > suites ):
+                    Runner( std::move( suites ), { 0, nullptr } )
+                {}
+                
+                Runner( std::vector< Suite > suites, const Arguments & args ):
+                    _suites(        std::move( suites ) ),
+                    _jobs(          args.GetJobs() ),
+                    _history(       args.GetHistory() ),
+                    _isolate(       args.GetIsolate() ),
+                    _flush(         args.GetFlushMode() ),
+                    _quiet(         args.GetQuiet() ),
+                    _verbose(       args.GetVerbose() ),
+                    _color(         args.GetColorMode() ),
+                    _junit(         args.GetJUnit() ),
+                    _json(          args.GetJSON() ),
+                    _shards(        args.GetTotalShards() ),
+                    _shard(         args.GetShardIndex() ),
+                    _seed(          args.GetSeed() ),
+                    _shuffle(       args.GetShuffle() ),
+                    _timeout(       args.GetTimeout() ),
+                    _globalTimeout( args.GetGlobalTimeout() ),
+                    _repeat(        args.GetRepeat() ),
+                    _untilFail(     args.GetUntilFail() ),
+                    _trials(        args.GetPropertyTrials() ),
+                    _propertyJobs(  args.GetPropertyJobs() )
+                {}
                 
                 Runner( const Runner & o ):
-                    Runner( o._suites )
+                    _suites(        o._suites ),
+                    _jobs(          o._jobs ),
+                    _history(       o._history ),
+                    _isolate(       o._isolate ),
+                    _flush(         o._flush ),
+                    _quiet(         o._quiet ),
+                    _verbose(       o._verbose ),
+                    _color(         o._color ),
+                    _junit(         o._junit ),
+                    _json(          o._json ),
+                    _shards(        o._shards ),
+                    _shard(         o._shard ),
+                    _seed(          o._seed ),
+                    _shuffle(       o._shuffle ),
+                    _timeout(       o._timeout ),
+                    _globalTimeout( o._globalTimeout ),
+                    _repeat(        o._repeat ),
+                    _untilFail(     o._untilFail ),
+                    _trials(        o._trials ),
+                    _propertyJobs(  o._propertyJobs )
                 {}
                 
                 Runner( Runner && o ) noexcept:
-                    _suites( std::move( o._suites ) )
+                    _suites(        std::move( o._suites ) ),
+                    _jobs(          std::move( o._jobs ) ),
+                    _history(       std::move( o._history ) ),
+                    _isolate(       std::move( o._isolate ) ),
+                    _flush(         std::move( o._flush ) ),
+                    _quiet(         std::move( o._quiet ) ),
+                    _verbose(       std::move( o._verbose ) ),
+                    _color(         std::move( o._color ) ),
+                    _junit(         std::move( o._junit ) ),
+                    _json(          std::move( o._json ) ),
+                    _shards(        std::move( o._shards ) ),
+                    _shard(         std::move( o._shard ) ),
+                    _seed(          std::move( o._seed ) ),
+                    _shuffle(       std::move( o._shuffle ) ),
+                    _timeout(       std::move( o._timeout ) ),
+                    _globalTimeout( std::move( o._globalTimeout ) ),
+                    _repeat(        std::move( o._repeat ) ),
+                    _untilFail(     std::move( o._untilFail ) ),
+                    _trials(        std::move( o._trials ) ),
+                    _propertyJobs(  std::move( o._propertyJobs ) )
                 {}
                 
                 ~Runner()
@@ -80,115 +155,568 @@ namespace XS
                     return *( this );
                 }
                 
-                std::vector< Suite > GetSuites() const
+                const std::vector< Suite > & GetSuites() const
                 {
                     return this->_suites;
                 }
                 
                 bool Run( Optional< std::reference_wrapper< std::ostream > > os )
                 {
-                    size_t    suites( 0 );
-                    size_t    cases( 0 );
-                    StopWatch time;
-                    bool      success( true );
+                    size_t                                   suites( 0 );
+                    size_t                                   cases( 0 );
+                    StopWatch                                time;
+                    bool                                     success( true );
+                    std::vector< std::unique_ptr< Report > > reports;
+                    std::mutex                               output;
+                    
+                    Logging::SetQuiet( this->_quiet );
+                    Logging::SetVerbose( this->_verbose );
+                    TermColor::SetMode( this->_color );
+                    Property::SetSeed( this->_seed );
+                    Property::SetTrials( this->_trials );
+                    Property::SetJobs( this->_propertyJobs );
+                    
+                    if( this->_flush == Logging::FlushMode::Auto )
+                    {
+                        Logging::SetFlushMode( ( os.HasValue() && Logging::IsTerminal( os->get() ) ) ? Logging::FlushMode::Line : Logging::FlushMode::Suite );
+                    }
+                    else
+                    {
+                        Logging::SetFlushMode( this->_flush );
+                    }
+                    
+                    /* The standard stream gets its original buffer back when the run is over */
+                    Logging::CrashFlushing crashFlushing( os );
+                    
+                    /* An invalid shard would silently run nothing, and hide the test cases of the missing shard */
+                    if( this->_shards > 0 && this->_shard >= this->_shards )
+                    {
+                        Logging::Log( os, "Invalid shard index " + std::to_string( this->_shard ) + " (total shards: " + std::to_string( this->_shards ) + ")", {}, Logging::Style::Failure );
+                        Logging::Flush( os );
+                        
+                        return false;
+                    }
                     
                     if( this->_suites.size() == 0 )
                     {
                         Logging::Log( os, "No test to run...", {}, Logging::Style::Failure );
+                        Logging::Flush( os );
                         
                         return false;
                     }
                     
+                    reports = this->OpenReports( os );
+                    
+                    if( this->_shuffle )
+                    {
+                        Logging::Log( os, "Random seed: " + std::to_string( this->_seed ) + " (replay with --seed=" + std::to_string( this->_seed ) + ")" );
+                    }
+                    
                     suites += this->_suites.size();
                     
                     for( const auto & suite: this->_suites )
                     {
                         cases += suite.GetInfos().size();
+                        
+                        Environment::AddUsers( suite.GetName().c_str(), suite.GetInfos().size() );
                     }
                     
-                    Logging::Log( os, "Running " + Utility::Numbered( "test case", cases ) + " from " + Utility::Numbered( "test suite", suites ) );
+                    Watchdog watchdog
+                    (
+                        this->_timeout,
+                        this->_globalTimeout,
+                        os,
+                        output,
+                        [ & ]( const std::vector< Info > & expired, const std::vector< const Info * > & running )
+                        {
+                            this->Abort( os, output, expired, running, reports, time, suites, cases );
+                        }
+                    );
                     
-                    time.Start();
+                    #ifndef _WIN32
                     
-                    for( auto & suite: this->_suites )
+                    if( this->_isolate )
                     {
-                        if( suite.Run( os ) == false )
+                        Logging::Log( os, "Running " + Utility::Numbered( "test case", cases ) + " from " + Utility::Numbered( "test suite", suites ) + " (" + Utility::Numbered( "isolated worker", this->_jobs ) + ")", {}, Logging::Style::None, Logging::Options::Detail );
+                        
+                        time.Start();
+                        
                         {
-                            success = false;
+                            Isolation isolation( this->_jobs, os, output, watchdog );
+                            
+                            watchdog.Start();
+                            
+                            success = this->RunParallel( os, output, Reporting( Repeating( [ & ]( Info & info, Optional< std::reference_wrapper< std::ostream > > infoOS ) { return isolation.Run( info, infoOS ); }, this->_repeat, this->_untilFail ), reports ) );
+                            
+                            if( isolation.TearDown() == false )
+                            {
+                                success = false;
+                            }
                         }
                     }
+                    else
                     
-                    time.Stop();
+                    #endif
                     
+                    if( this->_jobs > 1 )
+                    {
+                        Logging::Log( os, "Running " + Utility::Numbered( "test case", cases ) + " from " + Utility::Numbered( "test suite", suites ) + " (" + Utility::Numbered( "job", this->_jobs ) + ")", {}, Logging::Style::None, Logging::Options::Detail );
+                        
+                        time.Start();
+                        watchdog.Start();
+                        
+                        success = this->RunParallel( os, output, Releasing( Reporting( Repeating( Watching( []( Info & info, Optional< std::reference_wrapper< std::ostream > > infoOS ) { return info.Run( infoOS ); }, watchdog ), this->_repeat, this->_untilFail ), reports ) ) );
+                    }
+                    else
                     {
-                        std::vector< Info > passed;
-                        std::vector< Info > failed;
+                        Logging::Log( os, "Running " + Utility::Numbered( "test case", cases ) + " from " + Utility::Numbered( "test suite", suites ), {}, Logging::Style::None, Logging::Options::Detail );
+                        
+                        time.Start();
+                        watchdog.Start();
+                        
+                        std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > execute
+                        (
+                            Releasing( Reporting( Repeating( Watching( []( Info & info, Optional< std::reference_wrapper< std::ostream > > infoOS ) { return info.Run( infoOS ); }, watchdog ), this->_repeat, this->_untilFail ), reports ) )
+                        );
                         
                         for( auto & suite: this->_suites )
                         {
-                            for( auto & info: suite.GetInfos() )
+                            if( suite.Run( os, execute ) == false )
                             {
-                                if( info.GetStatus() == Info::Status::Failed )
-                                {
-                                    failed.push_back( info );
-                                }
-                                else if( info.GetStatus() == Info::Status::Success )
-                                {
-                                    passed.push_back( info );
-                                }
+                                success = false;
                             }
                         }
+                    }
+                    
+                    if( Suite::TearDownAll( os ) == false )
+                    {
+                        success = false;
+                    }
+                    
+                    watchdog.Stop();
+                    Environment::TearDown();
+                    time.Stop();
+                    this->SaveHistory( this->GetInfos( {} ) );
+                    this->Summary( os, this->GetInfos( {} ), suites, cases, time.GetString() );
+                    
+                    return success;
+                }
+                
+                friend void swap( Runner & o1, Runner & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._suites,        o2._suites );
+                    swap( o1._jobs,          o2._jobs );
+                    swap( o1._history,       o2._history );
+                    swap( o1._isolate,       o2._isolate );
+                    swap( o1._flush,         o2._flush );
+                    swap( o1._quiet,         o2._quiet );
+                    swap( o1._verbose,       o2._verbose );
+                    swap( o1._color,         o2._color );
+                    swap( o1._junit,         o2._junit );
+                    swap( o1._json,          o2._json );
+                    swap( o1._shards,        o2._shards );
+                    swap( o1._shard,         o2._shard );
+                    swap( o1._seed,          o2._seed );
+                    swap( o1._shuffle,       o2._shuffle );
+                    swap( o1._timeout,       o2._timeout );
+                    swap( o1._globalTimeout, o2._globalTimeout );
+                    swap( o1._repeat,        o2._repeat );
+                    swap( o1._untilFail,     o2._untilFail );
+                    swap( o1._trials,        o2._trials );
+                    swap( o1._propertyJobs,  o2._propertyJobs );
+                }
+                
+            private:
+                
+                static bool Compare( const Info * o1, const Info * o2 )
+                {
+                    int result( strcmp( o1->GetRegistration().GetSuiteName(), o2->GetRegistration().GetSuiteName() ) );
+                    
+                    if( result == 0 )
+                    {
+                        result = strcmp( o1->GetRegistration().GetCaseName(), o2->GetRegistration().GetCaseName() );
+                    }
+                    
+                    return ( result == 0 ) ? o1->GetParameterIndex() < o2->GetParameterIndex() : result < 0;
+                }
+                
+                void Summary( Optional< std::reference_wrapper< std::ostream > > os, const std::vector< const Info * > & infos, size_t suites, size_t cases, const std::string & duration ) const
+                {
+                    std::vector< const Info * > passed;
+                    std::vector< const Info * > failed;
+                    
+                    passed.reserve( cases );
+                    failed.reserve( cases );
+                    
+                    for( const auto & info: infos )
+                    {
+                        if( info->GetStatus() == Info::Status::Failed || info->GetStatus() == Info::Status::TimedOut )
+                        {
+                            failed.push_back( info );
+                        }
+                        else if( info->GetStatus() == Info::Status::Success )
+                        {
+                            passed.push_back( info );
+                        }
+                    }
+                    
+                    Logging::Log( os, Utility::Numbered( "test case", cases ) + " from " + Utility::Numbered( "test suite", suites ) + " ran (" + duration + " total)", {}, Logging::Style::None, Logging::Options::NewLineBefore );
+                    Logging::Log( os, Utility::Numbered( "test", passed.size() ) + " passed:", ( ( passed.size() > 0 ) ? TermColor::Green() : TermColor::Red() ) );
+                    
+                    std::sort( passed.begin(), passed.end(), &Runner::Compare );
+                    
+                    if( Logging::IsQuiet() == false )
+                    {
+                        for( const auto & info: passed )
+                        {
+                            #ifdef _WIN32
+                            Logging::Log( os, info->GetSuiteName().c_str(), info->GetCaseName().c_str(), "  - " );
+                            #else
+                            Logging::Log( os, info->GetSuiteName().c_str(), info->GetCaseName().c_str(), "  - ✅ " );
+                            #endif
+                        }
+                    }
+                    
+                    if( failed.size() > 0 )
+                    {
+                        std::sort( failed.begin(), failed.end(), &Runner::Compare );
                         
-                        Logging::Log( os, Utility::Numbered( "test case", cases ) + " from " + Utility::Numbered( "test suite", suites ) + " ran (" + time.GetString() + " total)", {}, Logging::Style::None, Logging::Options::NewLineBefore );
-                        Logging::Log( os, Utility::Numbered( "test", passed.size() ) + " passed:", ( ( passed.size() > 0 ) ? TermColor::Green() : TermColor::Red() ) );
-                        
-                        std::sort( passed.begin(), passed.end(), []( const Info & o1, const Info & o2 ) { return o1.GetName() < o2.GetName(); } );
+                        Logging::Log( os, Utility::Numbered( "test", failed.size() ) + " failed:", TermColor::Red() );
                         
-                        for( const auto & info: passed )
+                        for( const auto & info: failed )
                         {
                             #ifdef _WIN32
-                            Logging::Log( os, info.GetSuiteName(), info.GetCaseName(), "  - " );
+                            Logging::Log( os, info->GetSuiteName().c_str(), info->GetCaseName().c_str(), "  - " );
                             #else
-                            Logging::Log( os, info.GetSuiteName(), info.GetCaseName(), "  - ✅ " );
+                            Logging::Log( os, info->GetSuiteName().c_str(), info->GetCaseName().c_str(), "  - ❌ " );
                             #endif
                         }
                         
-                        if( failed.size() > 0 )
+                        Logging::Log( os, "TESTING FAILED", TermColor::Red(), Logging::Style::None, Logging::Options::NewLineBefore );
+                    }
+                    else
+                    {
+                        Logging::Log( os, "TESTING PASSED", TermColor::Green(), Logging::Style::None, Logging::Options::NewLineBefore );
+                    }
+                    
+                    Logging::Flush( os );
+                }
+                
+                /* Running test cases still own their Info, so only the snapshots of expired ones are reported in their place */
+                void Abort( Optional< std::reference_wrapper< std::ostream > > os, std::mutex & output, const std::vector< Info > & expired, const std::vector< const Info * > & running, const std::vector< std::unique_ptr< Report > > & reports, StopWatch & time, size_t suites, size_t cases )
+                {
+                    std::lock_guard< std::mutex > l( output );
+                    std::vector< const Info * >   infos( this->GetInfos( running ) );
+                    
+                    time.Stop();
+                    
+                    for( const auto & info: expired )
+                    {
+                        infos.push_back( &info );
+                    }
+                    
+                    for( const auto & report: reports )
+                    {
+                        for( const auto & info: expired )
+                        {
+                            report->Add( info );
+                        }
+                        
+                        report->Close();
+                    }
+                    
+                    this->SaveHistory( infos );
+                    this->Summary( os, infos, suites, cases, time.GetString() );
+                    
+                    /* Test cases which are still running cannot be stopped, so the process exits without unwinding */
+                    std::_Exit( EXIT_FAILURE );
+                }
+                
+                bool RunParallel( Optional< std::reference_wrapper< std::ostream > > os, std::mutex & output, std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > execute )
+                {
+                    ThreadPool                                           pool( this->_jobs );
+                    std::vector< std::function< void() > >               tasks;
+                    std::vector< Optional< std::chrono::microseconds > > durations;
+                    std::vector< std::chrono::microseconds >             median;
+                    std::vector< size_t >                                order;
+                    std::string                                          name;
+                    
+                    for( auto & suite: this->_suites )
+                    {
+                        Span< Info >                           infos( suite.GetInfos() );
+                        std::vector< std::function< void() > > suiteTasks( suite.GetTasks( os, output, execute ) );
+                        
+                        for( size_t i = 0; i < suiteTasks.size(); i++ )
+                        {
+                            Optional< std::chrono::microseconds > duration;
+                            
+                            if( this->_history.IsEmpty() == false )
+                            {
+                                infos[ i ].GetName( name );
+                                
+                                duration = this->_history.GetDuration( name );
+                            }
+                            
+                            if( duration.HasValue() )
+                            {
+                                median.push_back( duration.Value() );
+                            }
+                            
+                            order.push_back( tasks.size() );
+                            tasks.push_back( std::move( suiteTasks[ i ] ) );
+                            durations.push_back( duration );
+                        }
+                    }
+                    
+                    /* Test cases without history are estimated with the median duration, so they are scheduled among the others instead of before them */
+                    if( median.size() > 0 )
+                    {
+                        std::nth_element( median.begin(), median.begin() + static_cast< std::ptrdiff_t >( median.size() / 2 ), median.end() );
+                        
+                        for( auto & duration: durations )
+                        {
+                            if( duration.HasValue() == false )
+                            {
+                                duration = median[ median.size() / 2 ];
+                            }
+                        }
+                        
+                        std::stable_sort
+                        (
+                            order.begin(),
+                            order.end(),
+                            [ & ]( size_t o1, size_t o2 )
+                            {
+                                return durations[ o1 ].Value() > durations[ o2 ].Value();
+                            }
+                        );
+                    }
+                    
+                    for( size_t i: order )
+                    {
+                        pool.Submit( std::move( tasks[ i ] ) );
+                    }
+                    
+                    pool.Wait();
+                    
+                    for( const auto & suite: this->_suites )
+                    {
+                        for( const auto & info: suite.GetInfos() )
                         {
-                            std::sort( failed.begin(), failed.end(), []( const Info & o1, const Info & o2 ) { return o1.GetName() < o2.GetName(); } );
+                            if( info.GetStatus() != Info::Status::Success )
+                            {
+                                return false;
+                            }
+                        }
+                    }
+                    
+                    return true;
+                }
+                
+                static std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > Watching( std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > execute, Watchdog & watchdog )
+                {
+                    if( watchdog.IsEnabled() == false )
+                    {
+                        return execute;
+                    }
+                    
+                    return [ execute, &watchdog ]( Info & info, Optional< std::reference_wrapper< std::ostream > > os )
+                    {
+                        uint64_t watch( watchdog.Watch( info ) );
+                        bool     success( execute( info, os ) );
+                        
+                        watchdog.Unwatch( watch );
+                        
+                        return success;
+                    };
+                }
+                
+                static std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > Repeating( std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > execute, size_t repeat, bool untilFail )
+                {
+                    if( repeat <= 1 && untilFail == false )
+                    {
+                        return execute;
+                    }
+                    
+                    return [ execute, repeat, untilFail ]( Info & info, Optional< std::reference_wrapper< std::ostream > > os )
+                    {
+                        std::vector< double > durations;
+                        Optional< Info >      failed;
+                        std::string           output;
+                        size_t                failures( 0 );
+                        
+                        /* Without a count, --until-fail runs until the first failure */
+                        for( size_t i = 0; repeat == 0 || i < repeat; i++ )
+                        {
+                            std::ostringstream buffer;
+                            bool               success;
+                            
+                            if( os.HasValue() )
+                            {
+                                TermColor::Mirror( buffer, os->get() );
+                                
+                                success = execute( info, std::reference_wrapper< std::ostream >( buffer ) );
+                            }
+                            else
+                            {
+                                success = execute( info, {} );
+                            }
                             
-                            Logging::Log( os, Utility::Numbered( "test", failed.size() ) + " failed:", TermColor::Red() );
+                            durations.push_back( static_cast< double >( info.GetDuration().count() ) );
                             
-                            for( const auto & info: failed )
+                            /* Only the first failed run is shown and reported, or the last run if none failed */
+                            if( success == false && failures++ == 0 )
+                            {
+                                failed = info;
+                                output = buffer.str();
+                            }
+                            else if( failures == 0 )
                             {
-                                #ifdef _WIN32
-                                Logging::Log( os, info.GetSuiteName(), info.GetCaseName(), "  - " );
-                                #else
-                                Logging::Log( os, info.GetSuiteName(), info.GetCaseName(), "  - ❌ " );
-                                #endif
+                                output = buffer.str();
                             }
                             
-                            Logging::Log( os, "TESTING FAILED", TermColor::Red(), Logging::Style::None, Logging::Options::NewLineBefore );
+                            if( success == false && untilFail )
+                            {
+                                break;
+                            }
                         }
-                        else
+                        
+                        if( failed.HasValue() )
                         {
-                            Logging::Log( os, "TESTING PASSED", TermColor::Green(), Logging::Style::None, Logging::Options::NewLineBefore );
+                            info = failed.Value();
                         }
+                        
+                        info._repetition = Repetition( durations.size(), failures, Statistics( durations ) );
+                        
+                        if( os.HasValue() )
+                        {
+                            os->get() << output;
+                            
+                            Logging::Log( os, info._repetition.Value() );
+                        }
+                        
+                        return failures == 0;
+                    };
+                }
+                
+                /* Resources used by a suite are released once its last test case has run, while isolated workers release them when exiting */
+                static std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > Releasing( std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > execute )
+                {
+                    return [ execute ]( Info & info, Optional< std::reference_wrapper< std::ostream > > os )
+                    {
+                        bool success( execute( info, os ) );
+                        
+                        Environment::RemoveUser( info.GetRegistration().GetSuiteName() );
+                        
+                        return success;
+                    };
+                }
+                
+                static std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > Reporting( std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > execute, const std::vector< std::unique_ptr< Report > > & reports )
+                {
+                    if( reports.size() == 0 )
+                    {
+                        return execute;
                     }
                     
-                    return success;
+                    return [ execute, &reports ]( Info & info, Optional< std::reference_wrapper< std::ostream > > os )
+                    {
+                        bool success( execute( info, os ) );
+                        
+                        for( const auto & report: reports )
+                        {
+                            report->Add( info );
+                        }
+                        
+                        return success;
+                    };
                 }
                 
-                friend void swap( Runner & o1, Runner & o2 ) noexcept
+                std::vector< std::unique_ptr< Report > > OpenReports( Optional< std::reference_wrapper< std::ostream > > os ) const
                 {
-                    using std::swap;
+                    std::vector< std::unique_ptr< Report > >                reports;
+                    std::vector< std::pair< Report::Format, std::string > > paths( { { Report::Format::JUnit, this->_junit }, { Report::Format::JSON, this->_json } } );
+                    
+                    for( const auto & p: paths )
+                    {
+                        if( p.second.length() == 0 )
+                        {
+                            continue;
+                        }
+                        
+                        std::unique_ptr< Report > report( new Report( p.first, p.second ) );
+                        
+                        if( report->IsGood() == false )
+                        {
+                            Logging::Log( os, "Cannot write report to " + p.second, {}, Logging::Style::Failure );
+                            
+                            continue;
+                        }
+                        
+                        reports.push_back( std::move( report ) );
+                    }
                     
-                    swap( o1._suites, o2._suites );
+                    return reports;
                 }
                 
-            private:
+                std::vector< const Info * > GetInfos( const std::vector< const Info * > & excluded ) const
+                {
+                    std::vector< const Info * > infos;
+                    
+                    for( const auto & suite: this->_suites )
+                    {
+                        for( const auto & info: suite.GetInfos() )
+                        {
+                            if( std::find( excluded.begin(), excluded.end(), &info ) == excluded.end() )
+                            {
+                                infos.push_back( &info );
+                            }
+                        }
+                    }
+                    
+                    return infos;
+                }
+                
+                void SaveHistory( const std::vector< const Info * > & infos )
+                {
+                    if( this->_history.GetPath().length() == 0 )
+                    {
+                        return;
+                    }
+                    
+                    for( const auto & info: infos )
+                    {
+                        if( info->GetStatus() != Info::Status::Unknown && info->GetStatus() != Info::Status::Running )
+                        {
+                            this->_history.SetDuration( info->GetName(), std::chrono::duration_cast< std::chrono::microseconds >( info->GetDuration() ) );
+                        }
+                    }
+                    
+                    this->_history.Save();
+                }
                 
-                std::vector< Suite > _suites;
+                std::vector< Suite >      _suites;
+                size_t                    _jobs;
+                History                   _history;
+                bool                      _isolate;
+                Logging::FlushMode        _flush;
+                bool                      _quiet;
+                bool                      _verbose;
+                TermColor::Mode           _color;
+                std::string               _junit;
+                std::string               _json;
+                size_t                    _shards;
+                size_t                    _shard;
+                uint32_t                  _seed;
+                bool                      _shuffle;
+                std::chrono::milliseconds _timeout;
+                std::chrono::milliseconds _globalTimeout;
+                size_t                    _repeat;
+                bool                      _untilFail;
+                size_t                    _trials;
+                size_t                    _propertyJobs;
         };
     }
 }
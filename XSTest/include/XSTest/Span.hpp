@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Span.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_SPAN_HPP
+#define XS_TEST_SPAN_HPP
+
+#include <cstddef>
+
+namespace XS
+{
+    namespace Test
+    {
+        template< typename _T_ >
+        class Span
+        {
+            public:
+                
+                Span():
+                    _data( nullptr ),
+                    _size( 0 )
+                {}
+                
+                Span( _T_ * data, size_t size ):
+                    _data( data ),
+                    _size( size )
+                {}
+                
+                template< typename _U_ >
+                Span( const Span< _U_ > & o ):
+                    _data( o.begin() ),
+                    _size( o.size() )
+                {}
+                
+                size_t size() const noexcept
+                {
+                    return this->_size;
+                }
+                
+                bool empty() const noexcept
+                {
+                    return this->_size == 0;
+                }
+                
+                _T_ * begin() const noexcept
+                {
+                    return this->_data;
+                }
+                
+                _T_ * end() const noexcept
+                {
+                    return this->_data + this->_size;
+                }
+                
+                _T_ & operator []( size_t index ) const noexcept
+                {
+                    return this->_data[ index ];
+                }
+                
+            private:
+                
+                _T_  * _data;
+                size_t _size;
+        };
+    }
+}
+
+#endif /* XS_TEST_SPAN_HPP */
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Statistics.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_STATISTICS_HPP
+#define XS_TEST_STATISTICS_HPP
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Statistics
+        {
+            public:
+                
+                Statistics():
+                    Statistics( std::vector< double >() )
+                {}
+                
+                Statistics( std::vector< double > samples ):
+                    _samples( std::move( samples ) ),
+                    _mean( 0 ),
+                    _median( 0 ),
+                    _standardDeviation( 0 ),
+                    _min( 0 ),
+                    _max( 0 )
+                {
+                    double variance( 0 );
+                    
+                    if( this->_samples.size() == 0 )
+                    {
+                        return;
+                    }
+                    
+                    std::sort( this->_samples.begin(), this->_samples.end() );
+                    
+                    this->_min    = this->_samples.front();
+                    this->_max    = this->_samples.back();
+                    this->_mean   = std::accumulate( this->_samples.begin(), this->_samples.end(), 0.0 ) / static_cast< double >( this->_samples.size() );
+                    this->_median = ( this->_samples.size() % 2 == 0 ) ? ( this->_samples[ this->_samples.size() / 2 - 1 ] + this->_samples[ this->_samples.size() / 2 ] ) / 2 : this->_samples[ this->_samples.size() / 2 ];
+                    
+                    for( double sample: this->_samples )
+                    {
+                        variance += ( sample - this->_mean ) * ( sample - this->_mean );
+                    }
+                    
+                    if( this->_samples.size() > 1 )
+                    {
+                        this->_standardDeviation = std::sqrt( variance / static_cast< double >( this->_samples.size() - 1 ) );
+                    }
+                }
+                
+                Statistics( const Statistics & o ):
+                    _samples(           o._samples ),
+                    _mean(              o._mean ),
+                    _median(            o._median ),
+                    _standardDeviation( o._standardDeviation ),
+                    _min(               o._min ),
+                    _max(               o._max )
+                {}
+                
+                Statistics( Statistics && o ) noexcept:
+                    _samples(           std::move( o._samples ) ),
+                    _mean(              std::move( o._mean ) ),
+                    _median(            std::move( o._median ) ),
+                    _standardDeviation( std::move( o._standardDeviation ) ),
+                    _min(               std::move( o._min ) ),
+                    _max(               std::move( o._max ) )
+                {}
+                
+                ~Statistics()
+                {}
+                
+                Statistics & operator =( Statistics o )
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                const std::vector< double > & GetSamples() const noexcept
+                {
+                    return this->_samples;
+                }
+                
+                size_t GetCount() const noexcept
+                {
+                    return this->_samples.size();
+                }
+                
+                double GetMean() const noexcept
+                {
+                    return this->_mean;
+                }
+                
+                double GetMedian() const noexcept
+                {
+                    return this->_median;
+                }
+                
+                double GetStandardDeviation() const noexcept
+                {
+                    return this->_standardDeviation;
+                }
+                
+                double GetMin() const noexcept
+                {
+                    return this->_min;
+                }
+                
+                double GetMax() const noexcept
+                {
+                    return this->_max;
+                }
+                
+                friend void swap( Statistics & o1, Statistics & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._samples,           o2._samples );
+                    swap( o1._mean,              o2._mean );
+                    swap( o1._median,            o2._median );
+                    swap( o1._standardDeviation, o2._standardDeviation );
+                    swap( o1._min,               o2._min );
+                    swap( o1._max,               o2._max );
+                }
+                
+            private:
+                
+                std::vector< double > _samples;
+                double                _mean;
+                double                _median;
+                double                _standardDeviation;
+                double                _min;
+                double                _max;
+        };
+    }
+}
+
+#endif /* XS_TEST_STATISTICS_HPP */
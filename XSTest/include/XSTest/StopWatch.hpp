@@ -34,9 +34,16 @@
 #include <memory>
 #include <string>
 #include <cstdint>
+#include <cstdio>
 #include <chrono>
 #include <algorithm>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
 namespace XS
 {
     namespace Test
@@ -54,10 +61,67 @@ namespace XS
                 StopWatch( const StopWatch & o )              = delete;
                 StopWatch & operator =( const StopWatch & o ) = delete;
                 
+                static std::chrono::nanoseconds ThreadCPUTime()
+                {
+                    #ifdef _WIN32
+                    
+                    FILETIME creation;
+                    FILETIME exit;
+                    FILETIME kernel;
+                    FILETIME user;
+                    
+                    if( GetThreadTimes( GetCurrentThread(), &creation, &exit, &kernel, &user ) == FALSE )
+                    {
+                        return std::chrono::nanoseconds( 0 );
+                    }
+                    
+                    return FromFileTime( kernel ) + FromFileTime( user );
+                    
+                    #else
+                    
+                    return FromClock( CLOCK_THREAD_CPUTIME_ID );
+                    
+                    #endif
+                }
+                
+                static std::chrono::nanoseconds ProcessCPUTime()
+                {
+                    #ifdef _WIN32
+                    
+                    FILETIME creation;
+                    FILETIME exit;
+                    FILETIME kernel;
+                    FILETIME user;
+                    
+                    if( GetProcessTimes( GetCurrentProcess(), &creation, &exit, &kernel, &user ) == FALSE )
+                    {
+                        return std::chrono::nanoseconds( 0 );
+                    }
+                    
+                    return FromFileTime( kernel ) + FromFileTime( user );
+                    
+                    #else
+                    
+                    return FromClock( CLOCK_PROCESS_CPUTIME_ID );
+                    
+                    #endif
+                }
+                
+                static std::string Format( std::chrono::nanoseconds duration )
+                {
+                    char buffer[ 64 ];
+                    
+                    snprintf( buffer, sizeof( buffer ), "%.3f ms", static_cast< double >( duration.count() ) / 1e6 );
+                    
+                    return buffer;
+                }
+                
                 void Start()
                 {
-                    this->_start  = std::chrono::system_clock::now();
-                    this->_status = Status::Started;
+                    this->_startThreadCPU  = ThreadCPUTime();
+                    this->_startProcessCPU = ProcessCPUTime();
+                    this->_start           = std::chrono::steady_clock::now();
+                    this->_status          = Status::Started;
                 }
                 
                 void Stop()
@@ -67,41 +131,65 @@ namespace XS
                         return;
                     }
                     
-                    this->_end    = std::chrono::system_clock::now();
-                    this->_status = Status::Stopped;
+                    this->_end           = std::chrono::steady_clock::now();
+                    this->_endThreadCPU  = ThreadCPUTime();
+                    this->_endProcessCPU = ProcessCPUTime();
+                    this->_status        = Status::Stopped;
                 }
                 
-                int64_t GetSeconds() const
+                std::chrono::nanoseconds GetDuration() const
                 {
-                    std::chrono::duration< double > duration;
-                    
                     if( this->_status != Status::Stopped )
                     {
-                        return 0;
+                        return std::chrono::nanoseconds( 0 );
                     }
                     
-                    duration = { this->_end - this->_start };
-                    
-                    return std::chrono::duration_cast< std::chrono::seconds >( duration ).count();
+                    return std::chrono::duration_cast< std::chrono::nanoseconds >( this->_end - this->_start );
                 }
                 
-                int64_t GetMilliseconds() const
+                std::chrono::nanoseconds GetThreadCPUTime() const
                 {
-                    std::chrono::duration< double > duration;
-                    
                     if( this->_status != Status::Stopped )
                     {
-                        return 0;
+                        return std::chrono::nanoseconds( 0 );
                     }
                     
-                    duration = { this->_end - this->_start };
+                    return this->_endThreadCPU - this->_startThreadCPU;
+                }
+                
+                std::chrono::nanoseconds GetProcessCPUTime() const
+                {
+                    if( this->_status != Status::Stopped )
+                    {
+                        return std::chrono::nanoseconds( 0 );
+                    }
                     
-                    return std::chrono::duration_cast< std::chrono::milliseconds >( duration ).count();
+                    return this->_endProcessCPU - this->_startProcessCPU;
+                }
+                
+                int64_t GetSeconds() const
+                {
+                    return std::chrono::duration_cast< std::chrono::seconds >( this->GetDuration() ).count();
+                }
+                
+                int64_t GetMilliseconds() const
+                {
+                    return std::chrono::duration_cast< std::chrono::milliseconds >( this->GetDuration() ).count();
+                }
+                
+                int64_t GetMicroseconds() const
+                {
+                    return std::chrono::duration_cast< std::chrono::microseconds >( this->GetDuration() ).count();
+                }
+                
+                int64_t GetNanoseconds() const
+                {
+                    return this->GetDuration().count();
                 }
                 
                 std::string GetString() const
                 {
-                    return std::to_string( this->GetMilliseconds() ) + " ms";
+                    return Format( this->GetDuration() );
                 }
                 
             private:
@@ -113,8 +201,38 @@ namespace XS
                     Stopped
                 };
                 
-                std::chrono::time_point< std::chrono::system_clock > _start;
-                std::chrono::time_point< std::chrono::system_clock > _end;
+                #ifdef _WIN32
+                
+                static std::chrono::nanoseconds FromFileTime( const FILETIME & time )
+                {
+                    uint64_t ticks( ( static_cast< uint64_t >( time.dwHighDateTime ) << 32 ) | time.dwLowDateTime );
+                    
+                    /* FILETIME is expressed in 100 nanoseconds units */
+                    return std::chrono::nanoseconds( static_cast< int64_t >( ticks * 100 ) );
+                }
+                
+                #else
+                
+                static std::chrono::nanoseconds FromClock( clockid_t clock )
+                {
+                    struct timespec ts;
+                    
+                    if( clock_gettime( clock, &ts ) != 0 )
+                    {
+                        return std::chrono::nanoseconds( 0 );
+                    }
+                    
+                    return std::chrono::seconds( ts.tv_sec ) + std::chrono::nanoseconds( ts.tv_nsec );
+                }
+                
+                #endif
+                
+                std::chrono::time_point< std::chrono::steady_clock > _start;
+                std::chrono::time_point< std::chrono::steady_clock > _end;
+                std::chrono::nanoseconds                             _startThreadCPU;
+                std::chrono::nanoseconds                             _endThreadCPU;
+                std::chrono::nanoseconds                             _startProcessCPU;
+                std::chrono::nanoseconds                             _endProcessCPU;
                 Status                                               _status;
         };
     }
@@ -35,14 +35,28 @@
 #include <string>
 #include <iostream>
 #include <vector>
+#include <map>
+#include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <functional>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <random>
 #include <XSTest/Optional.hpp>
+#include <XSTest/Span.hpp>
 #include <XSTest/StopWatch.hpp>
 #include <XSTest/Utility.hpp>
 #include <XSTest/Info.hpp>
 #include <XSTest/Logging.hpp>
 #include <XSTest/TermColor.hpp>
 #include <XSTest/Arguments.hpp>
+#include <XSTest/History.hpp>
+#include <XSTest/Registration.hpp>
+#include <XSTest/SuiteFixtures.hpp>
 
 namespace XS
 {
@@ -56,39 +70,126 @@ namespace XS
                 
                 static std::vector< Suite > All( const Arguments & args )
                 {
-                    std::map< std::string, std::vector< Info > > all;
-                    std::vector< Suite >                         suites;
+                    std::vector< Info >                    infos;
+                    std::vector< size_t >                  order;
+                    std::shared_ptr< std::vector< Info > > table( std::make_shared< std::vector< Info > >() );
+                    std::vector< Suite >                   suites;
+                    std::mt19937                           engine( args.GetSeed() );
+                    std::string                            name;
+                    size_t                                 count( 0 );
                     
-                    for( auto & i: Info::All() )
+                    infos.reserve( GetRegistry().GetCount() );
+                    
+                    for( const Registration * r = GetRegistry().GetFirst(); r != nullptr; r = r->GetNext() )
+                    {
+                        if( r->IsParameterized() == false && args.ShouldRun( r->GetSuiteName(), r->GetCaseName() ) )
+                        {
+                            infos.push_back( Info( *( r ) ) );
+                        }
+                        
+                        /* Parameterized test cases are filtered by instance, reusing the same string for their names */
+                        for( size_t i = 0; i < r->GetParameterCount(); i++ )
+                        {
+                            name.assign( r->GetCaseName() ).append( "/" ).append( std::to_string( i ) );
+                            
+                            if( args.ShouldRun( r->GetSuiteName(), name.c_str() ) )
+                            {
+                                infos.push_back( Info( *( r ), i ) );
+                            }
+                        }
+                    }
+                    
+                    /* Sharding is done once parameterized test cases are expanded, so their instances are spread across shards */
+                    if( args.GetTotalShards() > 0 )
                     {
-                        if( args.ShouldRun( i.GetSuiteName(), i.GetCaseName() ) )
+                        order = Shard( infos, args.GetTotalShards(), args.GetShardIndex(), History( args.GetHistory() ) );
+                    }
+                    else
+                    {
+                        order.reserve( infos.size() );
+                        
+                        for( size_t i = 0; i < infos.size(); i++ )
                         {
-                            all[ i.GetSuiteName() ].push_back( i );
+                            order.push_back( i );
                         }
                     }
                     
-                    for( const auto & p: all )
+                    /* The run is shuffled once, and test cases are then grouped by suite, in the shuffled order of the suites */
+                    if( args.GetShuffle() )
+                    {
+                        Utility::Shuffle( order, engine );
+                        Group( infos, order );
+                    }
+                    else
+                    {
+                        std::stable_sort
+                        (
+                            order.begin(),
+                            order.end(),
+                            [ & ]( size_t o1, size_t o2 )
+                            {
+                                return strcmp( infos[ o1 ].GetRegistration().GetSuiteName(), infos[ o2 ].GetRegistration().GetSuiteName() ) < 0;
+                            }
+                        );
+                    }
+                    
+                    table->reserve( order.size() );
+                    
+                    for( size_t i: order )
                     {
-                        suites.push_back( Suite( p.first, p.second ) );
+                        table->push_back( std::move( infos[ i ] ) );
+                    }
+                    
+                    for( size_t i = 0; i < table->size(); i++ )
+                    {
+                        if( i == 0 || strcmp( ( *( table ) )[ i - 1 ].GetRegistration().GetSuiteName(), ( *( table ) )[ i ].GetRegistration().GetSuiteName() ) != 0 )
+                        {
+                            count++;
+                        }
+                    }
+                    
+                    suites.reserve( count );
+                    
+                    for( size_t i = 0, begin = 0; i < table->size(); i++ )
+                    {
+                        if( i + 1 == table->size() || strcmp( ( *( table ) )[ i + 1 ].GetRegistration().GetSuiteName(), ( *( table ) )[ i ].GetRegistration().GetSuiteName() ) != 0 )
+                        {
+                            suites.push_back( Suite( table, begin, i + 1 - begin ) );
+                            
+                            begin = i + 1;
+                        }
                     }
                     
                     return suites;
                 }
                 
-                Suite( const std::string & name, std::vector< Info > infos ):
-                    _name(  name ),
-                    _infos( infos )
+                /* Suites are torn down once their last test case ran, so this only catches suites left set up, like in isolated workers */
+                static bool TearDownAll( Optional< std::reference_wrapper< std::ostream > > os )
                 {
-                    Utility::Shuffle( this->_infos );
+                    bool success( true );
+                    
+                    for( const auto & p: SuiteFixtures::TearDownAll() )
+                    {
+                        Logging::Log( os, std::string( p.first ) + ": " + p.second.GetDescription(), {}, Logging::Style::Failure );
+                        
+                        success = false;
+                    }
+                    
+                    return success;
                 }
                 
                 Suite( const Suite & o ):
-                    Suite( o._name, o._infos )
+                    _name(  o._name ),
+                    _table( o._table ),
+                    _begin( o._begin ),
+                    _count( o._count )
                 {}
                 
                 Suite( Suite && o ) noexcept:
                     _name(  std::move( o._name ) ),
-                    _infos( std::move( o._infos ) )
+                    _table( std::move( o._table ) ),
+                    _begin( std::move( o._begin ) ),
+                    _count( std::move( o._count ) )
                 {}
                 
                 ~Suite()
@@ -106,52 +207,341 @@ namespace XS
                     return this->_name;
                 }
                 
-                std::vector< Info > GetInfos() const
+                Span< Info > GetInfos()
+                {
+                    return { this->_table->data() + this->_begin, this->_count };
+                }
+                
+                Span< const Info > GetInfos() const
                 {
-                    return this->_infos;
+                    return { this->_table->data() + this->_begin, this->_count };
                 }
                 
                 bool Run( Optional< std::reference_wrapper< std::ostream > > os )
+                {
+                    return this->Run( os, []( Info & info, Optional< std::reference_wrapper< std::ostream > > infoOS ) { return info.Run( infoOS ); } );
+                }
+                
+                bool Run( Optional< std::reference_wrapper< std::ostream > > os, std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > execute )
                 {
                     StopWatch time;
                     bool      success( true );
                     
-                    if( this->_infos.size() == 0 )
+                    if( this->_count == 0 )
                     {
                         return false;
                     }
                     
-                    Logging::Log( os, "Running " + Utility::Numbered( "test case", this->_infos.size() ) + " from " + this->_name, {}, Logging::Style::None, Logging::Options::NewLineBefore );
-                    
+                    this->LogStart( os );
                     time.Start();
                     
-                    for( auto & i: this->_infos )
+                    for( auto & i: this->GetInfos() )
                     {
-                        if( i.Run( os ) == false )
+                        if( execute( i, os ) == false )
                         {
                             success = false;
                         }
                     }
                     
-                    time.Stop();
+                    if( this->TearDown( os ) == false )
+                    {
+                        success = false;
+                    }
                     
-                    Logging::Log( os, Utility::Numbered( "test case", this->_infos.size() ) + " from " + this->_name + " ran (" + time.GetString() + " total)" );
+                    time.Stop();
+                    this->LogEnd( os, time );
                     
                     return success;
                 }
                 
+                std::vector< std::function< void() > > GetTasks( Optional< std::reference_wrapper< std::ostream > > os, std::mutex & output, std::function< bool( Info &, Optional< std::reference_wrapper< std::ostream > > ) > execute )
+                {
+                    std::shared_ptr< ParallelRun >         run;
+                    std::vector< std::function< void() > > tasks;
+                    
+                    if( this->_count == 0 )
+                    {
+                        return tasks;
+                    }
+                    
+                    run = std::make_shared< ParallelRun >( this->_count );
+                    
+                    for( size_t i = 0; i < this->_count; i++ )
+                    {
+                        tasks.push_back
+                        (
+                            [ this, os, run, execute, i, &output ]()
+                            {
+                                std::ostringstream buffer;
+                                
+                                if( run->started.exchange( true ) == false )
+                                {
+                                    run->time.Start();
+                                }
+                                
+                                if( os.HasValue() )
+                                {
+                                    TermColor::Mirror( buffer, os->get() );
+                                    
+                                    execute( this->GetInfos()[ i ], std::reference_wrapper< std::ostream >( buffer ) );
+                                    
+                                    run->outputs[ i ] = buffer.str();
+                                }
+                                else
+                                {
+                                    execute( this->GetInfos()[ i ], {} );
+                                }
+                                
+                                if( --( run->remaining ) == 0 )
+                                {
+                                    std::ostringstream teardown;
+                                    
+                                    if( os.HasValue() )
+                                    {
+                                        TermColor::Mirror( teardown, os->get() );
+                                        
+                                        this->TearDown( std::reference_wrapper< std::ostream >( teardown ) );
+                                    }
+                                    else
+                                    {
+                                        this->TearDown( {} );
+                                    }
+                                    
+                                    std::lock_guard< std::mutex > l( output );
+                                    
+                                    run->time.Stop();
+                                    this->LogStart( os );
+                                    
+                                    if( os.HasValue() )
+                                    {
+                                        for( const auto & s: run->outputs )
+                                        {
+                                            os->get() << s;
+                                        }
+                                        
+                                        os->get() << teardown.str();
+                                    }
+                                    
+                                    this->LogEnd( os, run->time );
+                                }
+                            }
+                        );
+                    }
+                    
+                    return tasks;
+                }
+                
                 friend void swap( Suite & o1, Suite & o2 ) noexcept
                 {
                     using std::swap;
                     
                     swap( o1._name,  o2._name );
-                    swap( o1._infos, o2._infos );
+                    swap( o1._table, o2._table );
+                    swap( o1._begin, o2._begin );
+                    swap( o1._count, o2._count );
                 }
                 
             private:
                 
-                std::string         _name;
-                std::vector< Info > _infos;
+                class ParallelRun
+                {
+                    public:
+                        
+                        ParallelRun( size_t count ):
+                            outputs(   count ),
+                            remaining( count ),
+                            started(   false )
+                        {}
+                        
+                        std::vector< std::string > outputs;
+                        std::atomic< size_t >      remaining;
+                        std::atomic< bool >        started;
+                        StopWatch                  time;
+                };
+                
+                static std::vector< size_t > Shard( const std::vector< Info > & infos, size_t shards, size_t shard, const History & history )
+                {
+                    std::string                              name;
+                    std::vector< size_t >                    order;
+                    std::vector< std::chrono::microseconds > durations( infos.size() );
+                    std::vector< bool >                      known( infos.size(), false );
+                    std::vector< bool >                      keep( infos.size(), false );
+                    std::vector< std::chrono::microseconds > loads( shards );
+                    std::vector< std::chrono::microseconds > median;
+                    std::vector< size_t >                    kept;
+                    
+                    #ifdef XSTEST_GTEST_COMPAT
+                    
+                    if( getenv( "GTEST_SHARD_STATUS_FILE" ) != nullptr )
+                    {
+                        std::ofstream( getenv( "GTEST_SHARD_STATUS_FILE" ) );
+                    }
+                    
+                    #endif
+                    
+                    order.reserve( infos.size() );
+                    
+                    for( size_t i = 0; i < infos.size(); i++ )
+                    {
+                        Optional< std::chrono::microseconds > duration;
+                        
+                        order.push_back( i );
+                        
+                        if( history.IsEmpty() == false )
+                        {
+                            infos[ i ].GetName( name );
+                            
+                            duration = history.GetDuration( name );
+                        }
+                        
+                        if( duration.HasValue() )
+                        {
+                            durations[ i ] = duration.Value();
+                            known[ i ]     = true;
+                            
+                            median.push_back( duration.Value() );
+                        }
+                    }
+                    
+                    /* Every shard must compute the same assignment, so cases are ordered by their registered names rather than by registration */
+                    std::sort
+                    (
+                        order.begin(),
+                        order.end(),
+                        [ & ]( size_t o1, size_t o2 )
+                        {
+                            const Registration & r1( infos[ o1 ].GetRegistration() );
+                            const Registration & r2( infos[ o2 ].GetRegistration() );
+                            int                  suite( strcmp( r1.GetSuiteName(), r2.GetSuiteName() ) );
+                            int                  test(  strcmp( r1.GetCaseName(),  r2.GetCaseName() ) );
+                            
+                            if( suite != 0 )
+                            {
+                                return suite < 0;
+                            }
+                            
+                            if( test != 0 )
+                            {
+                                return test < 0;
+                            }
+                            
+                            return infos[ o1 ].GetParameterIndex() < infos[ o2 ].GetParameterIndex();
+                        }
+                    );
+                    
+                    if( median.size() == 0 )
+                    {
+                        for( size_t i = 0; i < order.size(); i++ )
+                        {
+                            keep[ order[ i ] ] = i % shards == shard;
+                        }
+                    }
+                    else
+                    {
+                        std::nth_element( median.begin(), median.begin() + static_cast< std::ptrdiff_t >( median.size() / 2 ), median.end() );
+                        
+                        for( size_t i: order )
+                        {
+                            if( known[ i ] == false )
+                            {
+                                durations[ i ] = median[ median.size() / 2 ];
+                            }
+                        }
+                        
+                        std::stable_sort
+                        (
+                            order.begin(),
+                            order.end(),
+                            [ & ]( size_t o1, size_t o2 )
+                            {
+                                return durations[ o1 ] > durations[ o2 ];
+                            }
+                        );
+                        
+                        for( size_t i: order )
+                        {
+                            size_t lightest( static_cast< size_t >( std::min_element( loads.begin(), loads.end() ) - loads.begin() ) );
+                            
+                            loads[ lightest ] += durations[ i ];
+                            keep[ i ]          = lightest == shard;
+                        }
+                    }
+                    
+                    kept.reserve( infos.size() / shards + 1 );
+                    
+                    for( size_t i = 0; i < infos.size(); i++ )
+                    {
+                        if( keep[ i ] )
+                        {
+                            kept.push_back( i );
+                        }
+                    }
+                    
+                    return kept;
+                }
+                
+                static void Group( const std::vector< Info > & infos, std::vector< size_t > & order )
+                {
+                    std::map< const char *, size_t, bool ( * )( const char *, const char * ) > ranks( []( const char * s1, const char * s2 ) { return strcmp( s1, s2 ) < 0; } );
+                    std::vector< size_t >                                                      rank( infos.size() );
+                    
+                    for( size_t i: order )
+                    {
+                        rank[ i ] = ranks.insert( { infos[ i ].GetRegistration().GetSuiteName(), ranks.size() } ).first->second;
+                    }
+                    
+                    std::stable_sort
+                    (
+                        order.begin(),
+                        order.end(),
+                        [ & ]( size_t o1, size_t o2 )
+                        {
+                            return rank[ o1 ] < rank[ o2 ];
+                        }
+                    );
+                }
+                
+                bool TearDown( Optional< std::reference_wrapper< std::ostream > > os )
+                {
+                    bool success( true );
+                    
+                    for( const auto & info: this->GetInfos() )
+                    {
+                        Optional< Failure > failure( SuiteFixtures::TearDown( info.GetRegistration() ) );
+                        
+                        if( failure.HasValue() )
+                        {
+                            Logging::Log( os, std::string( this->_name ) + ": " + failure->GetDescription(), {}, Logging::Style::Failure );
+                            
+                            success = false;
+                        }
+                    }
+                    
+                    return success;
+                }
+                
+                void LogStart( Optional< std::reference_wrapper< std::ostream > > os ) const
+                {
+                    Logging::Log( os, "Running " + Utility::Numbered( "test case", this->_count ) + " from " + this->_name, {}, Logging::Style::None, { Logging::Options::NewLineBefore, Logging::Options::Detail } );
+                }
+                
+                void LogEnd( Optional< std::reference_wrapper< std::ostream > > os, const StopWatch & time ) const
+                {
+                    Logging::Log( os, Utility::Numbered( "test case", this->_count ) + " from " + this->_name + " ran (" + time.GetString() + " total)", {}, Logging::Style::None, Logging::Options::Detail );
+                    Logging::Flush( os );
+                }
+                
+                Suite( const std::shared_ptr< std::vector< Info > > & table, size_t begin, size_t count ):
+                    _name(  ( *( table ) )[ begin ].GetRegistration().GetSuiteName() ),
+                    _table( table ),
+                    _begin( begin ),
+                    _count( count )
+                {}
+                
+                const char *                           _name;
+                std::shared_ptr< std::vector< Info > > _table;
+                size_t                                 _begin;
+                size_t                                 _count;
         };
     }
 }
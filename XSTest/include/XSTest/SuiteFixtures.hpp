@@ -0,0 +1,244 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SuiteFixtures.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_SUITE_FIXTURES_HPP
+#define XS_TEST_SUITE_FIXTURES_HPP
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <memory>
+#include <mutex>
+#include <cstring>
+#include <exception>
+#include <algorithm>
+#include <XSTest/Optional.hpp>
+#include <XSTest/Failure.hpp>
+#include <XSTest/Collector.hpp>
+#include <XSTest/Case.hpp>
+#include <XSTest/Registration.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        class SuiteFixtures
+        {
+            public:
+                
+                SuiteFixtures() = delete;
+                
+                static Optional< Failure > SetUp( const Registration & registration )
+                {
+                    if( IsDefault( registration ) )
+                    {
+                        return {};
+                    }
+                    
+                    std::shared_ptr< Entry > entry( Get( registration ) );
+                    
+                    /* Only test cases from the same suite wait for it to be set up, while other suites keep running */
+                    std::call_once
+                    (
+                        entry->once,
+                        [ & ]
+                        {
+                            entry->failure = Call( registration.GetSetUpTestSuite(), "SetUpTestSuite", registration );
+                        }
+                    );
+                    
+                    return entry->failure;
+                }
+                
+                static Optional< Failure > TearDown( const Registration & registration )
+                {
+                    std::shared_ptr< Entry > entry;
+                    
+                    if( IsDefault( registration ) )
+                    {
+                        return {};
+                    }
+                    
+                    {
+                        std::lock_guard< std::mutex > l( SharedState().mutex );
+                        
+                        auto i = std::find_if( SharedState().entries.begin(), SharedState().entries.end(), [ & ]( const std::shared_ptr< Entry > & e ) { return IsSame( *( e ), registration ); } );
+                        
+                        if( i == SharedState().entries.end() )
+                        {
+                            return {};
+                        }
+                        
+                        entry = *( i );
+                        
+                        SharedState().entries.erase( i );
+                    }
+                    
+                    /* Nothing to tear down if the suite could not be set up */
+                    if( entry->failure.HasValue() )
+                    {
+                        return {};
+                    }
+                    
+                    return Call( registration.GetTearDownTestSuite(), "TearDownTestSuite", registration );
+                }
+                
+                static std::vector< std::pair< const char *, Failure > > TearDownAll()
+                {
+                    std::vector< std::shared_ptr< Entry > >           entries;
+                    std::vector< std::pair< const char *, Failure > > failures;
+                    
+                    {
+                        std::lock_guard< std::mutex > l( SharedState().mutex );
+                        
+                        std::swap( entries, SharedState().entries );
+                    }
+                    
+                    std::reverse( entries.begin(), entries.end() );
+                    
+                    for( const auto & entry: entries )
+                    {
+                        if( entry->failure.HasValue() == false )
+                        {
+                            Optional< Failure > failure( Call( entry->registration->GetTearDownTestSuite(), "TearDownTestSuite", *( entry->registration ) ) );
+                            
+                            if( failure.HasValue() )
+                            {
+                                failures.push_back( { entry->registration->GetSuiteName(), failure.Value() } );
+                            }
+                        }
+                    }
+                    
+                    return failures;
+                }
+                
+            private:
+                
+                class Entry
+                {
+                    public:
+                        
+                        explicit Entry( const Registration & r ):
+                            registration( &r )
+                        {}
+                        
+                        Entry( const Entry & o )              = delete;
+                        Entry & operator =( const Entry & o ) = delete;
+                        
+                        const Registration * registration;
+                        std::once_flag       once;
+                        Optional< Failure >  failure;
+                };
+                
+                class State
+                {
+                    public:
+                        
+                        std::mutex                              mutex;
+                        std::vector< std::shared_ptr< Entry > > entries;
+                };
+                
+                static State & SharedState()
+                {
+                    static State state;
+                    
+                    return state;
+                }
+                
+                static bool IsDefault( const Registration & registration )
+                {
+                    return ( registration.GetSetUpTestSuite()    == nullptr || registration.GetSetUpTestSuite()    == &Case::SetUpTestSuite )
+                        && ( registration.GetTearDownTestSuite() == nullptr || registration.GetTearDownTestSuite() == &Case::TearDownTestSuite );
+                }
+                
+                static std::shared_ptr< Entry > Get( const Registration & registration )
+                {
+                    std::lock_guard< std::mutex > l( SharedState().mutex );
+                    
+                    for( const auto & entry: SharedState().entries )
+                    {
+                        if( IsSame( *( entry ), registration ) )
+                        {
+                            return entry;
+                        }
+                    }
+                    
+                    SharedState().entries.push_back( std::make_shared< Entry >( registration ) );
+                    
+                    return SharedState().entries.back();
+                }
+                
+                /* Suites are identified by name, as different suites may inherit the same hooks, and by hooks, as typed test cases share a suite name */
+                static bool IsSame( const Entry & entry, const Registration & registration )
+                {
+                    return strcmp( entry.registration->GetSuiteName(), registration.GetSuiteName() ) == 0
+                        && entry.registration->GetSetUpTestSuite()    == registration.GetSetUpTestSuite()
+                        && entry.registration->GetTearDownTestSuite() == registration.GetTearDownTestSuite();
+                }
+                
+                static Optional< Failure > Call( void ( * f )(), const std::string & name, const Registration & registration )
+                {
+                    Collector        collector;
+                    Collector::Scope scope( collector );
+                    
+                    if( f == nullptr )
+                    {
+                        return {};
+                    }
+                    
+                    try
+                    {
+                        f();
+                    }
+                    catch( const Failure & e )
+                    {
+                        return e;
+                    }
+                    catch( const std::exception & e )
+                    {
+                        return Failure( "Caught unexpected exception in " + name + ": " + e.what(), registration.GetFile(), registration.GetLine() );
+                    }
+                    catch( ... )
+                    {
+                        return Failure( "Caught unexpected exception in " + name, registration.GetFile(), registration.GetLine() );
+                    }
+                    
+                    if( collector.GetCount() > 0 )
+                    {
+                        return collector.GetFailures().front();
+                    }
+                    
+                    return {};
+                }
+        };
+    }
+}
+
+#endif /* XS_TEST_SUITE_FIXTURES_HPP */
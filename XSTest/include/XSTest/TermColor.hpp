@@ -132,6 +132,28 @@ namespace XS
                     return *( this );
                 }
                 
+                enum class Mode
+                {
+                    Auto,
+                    Always,
+                    Never
+                };
+                
+                static Mode GetMode()
+                {
+                    return SharedMode();
+                }
+                
+                static void SetMode( Mode mode )
+                {
+                    SharedMode() = mode;
+                }
+                
+                static void Mirror( std::ostream & os, std::ostream & source )
+                {
+                    os.iword( StreamIndex() ) = static_cast< long >( Support( source ) );
+                }
+                
                 friend void swap( TermColor & o1, TermColor & o2 ) noexcept
                 {
                     using std::swap;
@@ -146,15 +168,18 @@ namespace XS
 
                 friend std::ostream & operator <<( std::ostream & os, const TermColor & color )
                 {
-                    if( SupportsANSISequences( os ) )
+                    StreamSupport support( Support( os ) );
+                    
+                    if( support == StreamSupport::ANSI )
                     {
                         os << ANSISequence( color._foreground );
                     }
 
                     #ifdef _WIN32
 
-                    else if( SupportsWindowsConsoleAttributes( os ) )
+                    else if( support == StreamSupport::Console )
                     {
+                        os.flush();
                         SetWindowsConsoleAttributes( os, color._foreground );
                     }
 
@@ -165,6 +190,72 @@ namespace XS
                 
             private:
                 
+                enum class StreamSupport: long
+                {
+                    Unknown = 0,
+                    ANSI    = 1,
+                    None    = 2,
+                    Console = 3
+                };
+                
+                static Mode & SharedMode()
+                {
+                    static Mode mode( Mode::Auto );
+                    
+                    return mode;
+                }
+                
+                static StreamSupport Support( std::ostream & os )
+                {
+                    StreamSupport support;
+                    
+                    if( SharedMode() == Mode::Always )
+                    {
+                        return StreamSupport::ANSI;
+                    }
+                    else if( SharedMode() == Mode::Never )
+                    {
+                        return StreamSupport::None;
+                    }
+                    
+                    support = static_cast< StreamSupport >( os.iword( StreamIndex() ) );
+                    
+                    if( support != StreamSupport::Unknown )
+                    {
+                        return support;
+                    }
+                    
+                    if( SupportsANSISequences( os ) )
+                    {
+                        support = StreamSupport::ANSI;
+                    }
+                    
+                    #ifdef _WIN32
+                    
+                    else if( SupportsWindowsConsoleAttributes( os ) )
+                    {
+                        support = StreamSupport::Console;
+                    }
+                    
+                    #endif
+                    
+                    else
+                    {
+                        support = StreamSupport::None;
+                    }
+                    
+                    os.iword( StreamIndex() ) = static_cast< long >( support );
+                    
+                    return support;
+                }
+                
+                static int StreamIndex()
+                {
+                    static int index = std::ios_base::xalloc();
+                    
+                    return index;
+                }
+                
                 #ifdef _WIN32
 
                 static Optional< WORD > DefaultConsoleAttributes( std::ostream & os )
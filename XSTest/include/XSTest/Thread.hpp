@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Thread.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_THREAD_HPP
+#define XS_TEST_THREAD_HPP
+
+#include <thread>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <string>
+#include <utility>
+#include <XSTest/Collector.hpp>
+#include <XSTest/Failure.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        class Thread
+        {
+            public:
+                
+                class Location
+                {
+                    public:
+                        
+                        Location( const char * file, size_t line ):
+                            _file( file ),
+                            _line( line )
+                        {}
+                        
+                        const char * GetFile() const
+                        {
+                            return this->_file;
+                        }
+                        
+                        size_t GetLine() const
+                        {
+                            return this->_line;
+                        }
+                        
+                    private:
+                        
+                        const char * _file;
+                        size_t       _line;
+                };
+                
+                Thread() noexcept
+                {}
+                
+                template< typename _F_, typename ... _A_ >
+                explicit Thread( _F_ && f, _A_ && ... args ):
+                    Thread( Location( "", 0 ), std::forward< _F_ >( f ), std::forward< _A_ >( args ) ... )
+                {}
+                
+                template< typename _F_, typename ... _A_ >
+                Thread( Location location, _F_ && f, _A_ && ... args ):
+                    _thread( &Thread::Run, Owner(), location, Bind( std::forward< _F_ >( f ), std::forward< _A_ >( args ) ... ) )
+                {}
+                
+                Thread( Thread && o ) noexcept:
+                    _thread( std::move( o._thread ) )
+                {}
+                
+                ~Thread()
+                {
+                    /* Failures can't be collected once the test case has returned */
+                    if( this->_thread.joinable() )
+                    {
+                        this->_thread.join();
+                    }
+                }
+                
+                Thread( const Thread & o ) = delete;
+                
+                Thread & operator =( Thread o ) noexcept
+                {
+                    swap( *( this ), o );
+                    
+                    return *( this );
+                }
+                
+                bool IsJoinable() const noexcept
+                {
+                    return this->_thread.joinable();
+                }
+                
+                std::thread::id GetID() const noexcept
+                {
+                    return this->_thread.get_id();
+                }
+                
+                void Join()
+                {
+                    this->_thread.join();
+                }
+                
+                friend void swap( Thread & o1, Thread & o2 ) noexcept
+                {
+                    using std::swap;
+                    
+                    swap( o1._thread, o2._thread );
+                }
+                
+            private:
+                
+                class Callable
+                {
+                    public:
+                        
+                        virtual ~Callable()
+                        {}
+                        
+                        virtual void operator ()() = 0;
+                };
+                
+                /* Holds the callable without copying it, so move-only callables can be used, like with std::packaged_task */
+                template< typename _F_ >
+                class Holder: public Callable
+                {
+                    public:
+                        
+                        explicit Holder( _F_ && f ):
+                            _f( std::move( f ) )
+                        {}
+                        
+                        void operator ()() override
+                        {
+                            this->_f();
+                        }
+                        
+                    private:
+                        
+                        _F_ _f;
+                };
+                
+                template< typename _F_, typename ... _A_ >
+                static std::unique_ptr< Callable > Bind( _F_ && f, _A_ && ... args )
+                {
+                    typedef decltype( std::bind( std::forward< _F_ >( f ), std::forward< _A_ >( args ) ... ) ) Bound;
+                    
+                    return std::unique_ptr< Callable >( new Holder< Bound >( std::bind( std::forward< _F_ >( f ), std::forward< _A_ >( args ) ... ) ) );
+                }
+                
+                static std::shared_ptr< Collector > Owner()
+                {
+                    /* The thread shares the failures of the test case that started it, and keeps them alive while it runs */
+                    return ( Collector::Current() == nullptr ) ? nullptr : std::make_shared< Collector >( *( Collector::Current() ) );
+                }
+                
+                static void Run( std::shared_ptr< Collector > collector, Location location, std::unique_ptr< Callable > f )
+                {
+                    if( collector == nullptr )
+                    {
+                        ( *( f ) )();
+                        
+                        return;
+                    }
+                    
+                    Collector::Scope scope( *( collector ) );
+                    
+                    try
+                    {
+                        ( *( f ) )();
+                    }
+                    catch( const Failure & e )
+                    {
+                        collector->Add( e );
+                    }
+                    catch( const std::exception & e )
+                    {
+                        collector->Add( Failure( std::string( "Caught unexpected exception in thread: " ) + e.what(), location.GetFile(), location.GetLine() ) );
+                    }
+                    catch( ... )
+                    {
+                        collector->Add( Failure( "Caught unexpected exception in thread", location.GetFile(), location.GetLine() ) );
+                    }
+                }
+                
+                std::thread _thread;
+        };
+    }
+}
+
+#endif /* XS_TEST_THREAD_HPP */
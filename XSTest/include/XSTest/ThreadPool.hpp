@@ -0,0 +1,277 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ThreadPool.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_THREAD_POOL_HPP
+#define XS_TEST_THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <algorithm>
+
+namespace XS
+{
+    namespace Test
+    {
+        class ThreadPool
+        {
+            public:
+                
+                static size_t DefaultConcurrency()
+                {
+                    unsigned int n( std::thread::hardware_concurrency() );
+                    
+                    return ( n == 0 ) ? 1 : n;
+                }
+                
+                explicit ThreadPool( size_t threads ):
+                    _next(    0 ),
+                    _queued(  0 ),
+                    _pending( 0 ),
+                    _stop(    false )
+                {
+                    threads = std::max< size_t >( threads, 1 );
+                    
+                    for( size_t i = 0; i < threads; i++ )
+                    {
+                        this->_queues.push_back( std::unique_ptr< Queue >( new Queue() ) );
+                    }
+                    
+                    for( size_t i = 0; i < threads; i++ )
+                    {
+                        this->_threads.push_back( std::thread( &ThreadPool::Work, this, i ) );
+                    }
+                }
+                
+                ~ThreadPool()
+                {
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        
+                        this->_stop = true;
+                    }
+                    
+                    this->_available.notify_all();
+                    
+                    for( auto & thread: this->_threads )
+                    {
+                        thread.join();
+                    }
+                }
+                
+                ThreadPool( const ThreadPool & o )              = delete;
+                ThreadPool & operator =( const ThreadPool & o ) = delete;
+                
+                size_t GetThreadCount() const
+                {
+                    return this->_threads.size();
+                }
+                
+                void Submit( std::function< void() > task )
+                {
+                    size_t index;
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        
+                        index = ( Owner() == this ) ? WorkerIndex() : this->_next++ % this->_queues.size();
+                        
+                        this->_queued++;
+                        this->_pending++;
+                    }
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_queues[ index ]->mutex );
+                        
+                        this->_queues[ index ]->tasks.push_back( std::move( task ) );
+                    }
+                    
+                    this->_available.notify_one();
+                }
+                
+                void Wait()
+                {
+                    std::exception_ptr            e;
+                    std::unique_lock< std::mutex > l( this->_mutex );
+                    
+                    this->_done.wait( l, [ this ] { return this->_pending == 0; } );
+                    
+                    std::swap( e, this->_exception );
+                    
+                    if( e != nullptr )
+                    {
+                        std::rethrow_exception( e );
+                    }
+                }
+                
+            private:
+                
+                class Queue
+                {
+                    public:
+                        
+                        std::mutex                            mutex;
+                        std::deque< std::function< void() > > tasks;
+                };
+                
+                static ThreadPool * & Owner()
+                {
+                    static thread_local ThreadPool * owner = nullptr;
+                    
+                    return owner;
+                }
+                
+                static size_t & WorkerIndex()
+                {
+                    static thread_local size_t index = 0;
+                    
+                    return index;
+                }
+                
+                bool Pop( size_t index, std::function< void() > & task )
+                {
+                    Queue                       & queue( *( this->_queues[ index ] ) );
+                    std::lock_guard< std::mutex > l( queue.mutex );
+                    
+                    if( queue.tasks.empty() )
+                    {
+                        return false;
+                    }
+                    
+                    task = std::move( queue.tasks.front() );
+                    
+                    queue.tasks.pop_front();
+                    
+                    return true;
+                }
+                
+                bool Steal( size_t index, std::function< void() > & task )
+                {
+                    for( size_t i = 1; i < this->_queues.size(); i++ )
+                    {
+                        Queue                       & queue( *( this->_queues[ ( index + i ) % this->_queues.size() ] ) );
+                        std::lock_guard< std::mutex > l( queue.mutex );
+                        
+                        if( queue.tasks.empty() == false )
+                        {
+                            task = std::move( queue.tasks.back() );
+                            
+                            queue.tasks.pop_back();
+                            
+                            return true;
+                        }
+                    }
+                    
+                    return false;
+                }
+                
+                void Work( size_t index )
+                {
+                    Owner()       = this;
+                    WorkerIndex() = index;
+                    
+                    while( true )
+                    {
+                        std::function< void() > task;
+                        
+                        if( this->Pop( index, task ) || this->Steal( index, task ) )
+                        {
+                            {
+                                std::lock_guard< std::mutex > l( this->_mutex );
+                                
+                                this->_queued--;
+                            }
+                            
+                            this->Execute( task );
+                            
+                            continue;
+                        }
+                        
+                        {
+                            std::unique_lock< std::mutex > l( this->_mutex );
+                            
+                            this->_available.wait( l, [ this ] { return this->_queued > 0 || this->_stop; } );
+                            
+                            if( this->_stop && this->_queued == 0 )
+                            {
+                                return;
+                            }
+                        }
+                    }
+                }
+                
+                void Execute( const std::function< void() > & task )
+                {
+                    std::exception_ptr e;
+                    
+                    try
+                    {
+                        task();
+                    }
+                    catch( ... )
+                    {
+                        e = std::current_exception();
+                    }
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        
+                        if( e != nullptr && this->_exception == nullptr )
+                        {
+                            this->_exception = e;
+                        }
+                        
+                        if( --( this->_pending ) == 0 )
+                        {
+                            this->_done.notify_all();
+                        }
+                    }
+                }
+                
+                std::vector< std::unique_ptr< Queue > > _queues;
+                std::vector< std::thread >              _threads;
+                std::mutex                              _mutex;
+                std::condition_variable                 _available;
+                std::condition_variable                 _done;
+                std::exception_ptr                      _exception;
+                size_t                                  _next;
+                size_t                                  _queued;
+                size_t                                  _pending;
+                bool                                    _stop;
+        };
+    }
+}
+
+#endif /* XS_TEST_THREAD_POOL_HPP */
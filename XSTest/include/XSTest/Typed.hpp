@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Typed.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_TYPED_HPP
+#define XS_TEST_TYPED_HPP
+
+#include <string>
+#include <XSTest/Registration.hpp>
+#include <XSTest/Utility.hpp>
+
+namespace XS
+{
+    namespace Test
+    {
+        template< typename ... _T_ >
+        class Types
+        {};
+        
+        template< template< typename > class _C_, typename _T_ >
+        class TypedRegistrar;
+        
+        template< template< typename > class _C_, typename ... _T_ >
+        class TypedRegistrar< _C_, Types< _T_ ... > >
+        {
+            public:
+                
+                TypedRegistrar( const char * suiteName, const char * caseName, const char * file, size_t line )
+                {
+                    size_t index( 0 );
+                    
+                    /* Expands to one registration per type, in the order of the type list */
+                    int expand[] = { 0, ( Register< _T_ >( suiteName, caseName, index++, file, line ), 0 ) ... };
+                    
+                    static_cast< void >( expand );
+                }
+                
+                TypedRegistrar( const TypedRegistrar & o )              = delete;
+                TypedRegistrar & operator =( const TypedRegistrar & o ) = delete;
+                
+            private:
+                
+                template< typename _U_ >
+                static void Register( const char * suiteName, const char * caseName, size_t index, const char * file, size_t line )
+                {
+                    /* Demangled type names contain spaces and colons, and differ between compilers, so they're only used for display */
+                    static const std::string  name( std::string( caseName ) + "/" + std::to_string( index ) );
+                    static const std::string  type( Utility::Typename< _U_ >() );
+                    static Registration       registration( suiteName, name.c_str(), &_C_< _U_ >::_Create, file, line, &_C_< _U_ >::SetUpTestSuite, &_C_< _U_ >::TearDownTestSuite, nullptr, type.c_str() );
+                    static const Registrar    registrar( registration );
+                }
+        };
+    }
+}
+
+#endif /* XS_TEST_TYPED_HPP */
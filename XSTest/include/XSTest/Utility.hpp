@@ -33,8 +33,13 @@
 
 #include <string>
 #include <random>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <typeinfo>
 
-#ifdef __clang__
+#if defined( __clang__ ) || defined( __GNUC__ )
 #include <cxxabi.h>
 #endif
 
@@ -59,30 +64,60 @@ namespace XS
                 return Numbered( s, count, s + "s" );
             }
             
-            template< typename _T_ >
-            void Shuffle( _T_ & o )
+            inline uint32_t RandomSeed()
             {
                 std::random_device rng;
-                std::mt19937       urng( rng() );
                 
-                std::shuffle( std::begin( o ), std::end( o ), urng );
+                return static_cast< uint32_t >( rng() );
             }
             
             template< typename _T_ >
-            std::string Typename( const _T_ & o )
+            void Shuffle( _T_ & o, std::mt19937 & engine )
             {
-                std::string name( typeid( o ).name() );
+                using std::swap;
+                
+                auto   begin( std::begin( o ) );
+                size_t count( static_cast< size_t >( std::distance( begin, std::end( o ) ) ) );
                 
-                #ifdef __clang__
+                /* Unlike std::shuffle, gives the same order for a seed with every standard library */
+                for( size_t i = count; i > 1; i-- )
                 {
-                    int s( 0 );
+                    swap( begin[ static_cast< std::ptrdiff_t >( i - 1 ) ], begin[ static_cast< std::ptrdiff_t >( engine() % i ) ] );
+                }
+            }
+            
+            inline std::string Demangle( const char * name )
+            {
+                #if defined( __clang__ ) || defined( __GNUC__ )
+                {
+                    int    s( 0 );
+                    char * demangled( abi::__cxa_demangle( name, nullptr, nullptr, &s ) );
                     
-                    name = abi::__cxa_demangle( name.c_str(), nullptr, nullptr, &s );
+                    if( demangled != nullptr )
+                    {
+                        std::string result( demangled );
+                        
+                        free( demangled );
+                        
+                        return result;
+                    }
                 }
                 #endif
                 
                 return name;
             }
+            
+            template< typename _T_ >
+            std::string Typename( const _T_ & o )
+            {
+                return Demangle( typeid( o ).name() );
+            }
+            
+            template< typename _T_ >
+            std::string Typename()
+            {
+                return Demangle( typeid( _T_ ).name() );
+            }
         }
     }
 }
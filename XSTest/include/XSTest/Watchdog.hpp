@@ -0,0 +1,479 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Watchdog.hpp
+ * @author      Jean-David Gadina - www.xs-labs.com
+ * @copyright   (c) 2018, Jean-David Gadina - www.xs-labs.com
+ */
+
+#ifndef XS_TEST_WATCHDOG_HPP
+#define XS_TEST_WATCHDOG_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <XSTest/Optional.hpp>
+#include <XSTest/Info.hpp>
+#include <XSTest/Failure.hpp>
+#include <XSTest/StopWatch.hpp>
+#include <XSTest/Logging.hpp>
+
+#ifndef _WIN32
+#include <csignal>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#endif
+
+#if defined( __APPLE__ ) || defined( __GLIBC__ )
+#include <execinfo.h>
+#define XSTEST_HAS_BACKTRACE
+#endif
+
+namespace XS
+{
+    namespace Test
+    {
+        class Watchdog
+        {
+            public:
+                
+                Watchdog( std::chrono::milliseconds timeout, std::chrono::milliseconds globalTimeout, Optional< std::reference_wrapper< std::ostream > > os, std::mutex & output, std::function< void( const std::vector< Info > &, const std::vector< const Info * > & ) > expired ):
+                    _timeout(       timeout ),
+                    _globalTimeout( globalTimeout ),
+                    _start(         std::chrono::steady_clock::now() ),
+                    _os(            os ),
+                    _output(        output ),
+                    _expired(       std::move( expired ) ),
+                    _next(          1 ),
+                    _stop(          false )
+                {
+                    if( this->IsEnabled() )
+                    {
+                        InstallStackHandler();
+                    }
+                }
+                
+                Watchdog( const Watchdog & o )              = delete;
+                Watchdog & operator =( const Watchdog & o ) = delete;
+                
+                ~Watchdog()
+                {
+                    this->Stop();
+                }
+                
+                /* The thread is started separately, so isolated workers can be forked while the runner is single-threaded */
+                void Start()
+                {
+                    if( this->IsEnabled() && this->_thread.joinable() == false )
+                    {
+                        this->_thread = std::thread( [ this ] { this->Loop(); } );
+                    }
+                }
+                
+                void Stop()
+                {
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        
+                        this->_stop = true;
+                    }
+                    
+                    this->_condition.notify_all();
+                    
+                    if( this->_thread.joinable() )
+                    {
+                        this->_thread.join();
+                    }
+                }
+                
+                bool IsEnabled() const noexcept
+                {
+                    return this->_timeout.count() > 0 || this->_globalTimeout.count() > 0;
+                }
+                
+                std::chrono::milliseconds GetTimeout() const noexcept
+                {
+                    return this->_timeout;
+                }
+                
+                std::chrono::milliseconds GetGlobalTimeout() const noexcept
+                {
+                    return this->_globalTimeout;
+                }
+                
+                uint64_t Watch( Info & info, std::function< void() > cancel = {} )
+                {
+                    uint64_t id( 0 );
+                    
+                    if( this->IsEnabled() == false )
+                    {
+                        return id;
+                    }
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        Entry                         entry;
+                        
+                        entry.info   = &info;
+                        entry.start  = std::chrono::steady_clock::now();
+                        entry.cancel = std::move( cancel );
+                        
+                        #ifndef _WIN32
+                        entry.thread = pthread_self();
+                        #endif
+                        
+                        id = this->_next++;
+                        
+                        this->_entries[ id ] = std::move( entry );
+                    }
+                    
+                    this->_condition.notify_all();
+                    
+                    return id;
+                }
+                
+                /* Returns the reason of the expiry, for the caller to publish it to the Info it owns */
+                Optional< std::string > Unwatch( uint64_t id )
+                {
+                    std::lock_guard< std::mutex > l( this->_mutex );
+                    auto                          i( this->_entries.find( id ) );
+                    Optional< std::string >       reason;
+                    
+                    if( i != this->_entries.end() )
+                    {
+                        if( i->second.expired )
+                        {
+                            reason = i->second.reason;
+                        }
+                        
+                        this->_entries.erase( i );
+                    }
+                    
+                    return reason;
+                }
+                
+                static void Expire( Info & info, std::chrono::nanoseconds duration, const std::string & reason )
+                {
+                    info._failure        = Failure( reason, info.GetFile(), info.GetLine() );
+                    info._failures       = std::vector< Failure >( 1, info._failure.Value() );
+                    info._status         = Info::Status::TimedOut;
+                    info._duration       = duration;
+                    info._threadCPUTime  = std::chrono::nanoseconds( 0 );
+                    info._processCPUTime = std::chrono::nanoseconds( 0 );
+                }
+                
+                #ifndef _WIN32
+                
+                static void Kill( pid_t pid )
+                {
+                    /* Gives the process a chance to print the stack of the test case before it's killed */
+                    kill( pid, StackSignal() );
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+                    kill( pid, SIGKILL );
+                }
+                
+                #endif
+                
+            private:
+                
+                class Entry
+                {
+                    public:
+                        
+                        Info                                * info     = nullptr;
+                        std::chrono::steady_clock::time_point start;
+                        std::function< void() >               cancel;
+                        bool                                  expired  = false;
+                        std::string                           reason;
+                        std::chrono::nanoseconds              duration = std::chrono::nanoseconds( 0 );
+                        
+                        #ifndef _WIN32
+                        pthread_t thread;
+                        #endif
+                };
+                
+                void Loop()
+                {
+                    std::unique_lock< std::mutex > l( this->_mutex );
+                    
+                    while( this->_stop == false )
+                    {
+                        std::chrono::steady_clock::time_point  now( std::chrono::steady_clock::now() );
+                        std::chrono::steady_clock::time_point  deadline( std::chrono::steady_clock::time_point::max() );
+                        bool                                   hung( false );
+                        std::vector< std::function< void() > > cancels;
+                        
+                        if( this->_globalTimeout.count() > 0 )
+                        {
+                            deadline = this->_start + this->_globalTimeout;
+                            
+                            if( now >= deadline )
+                            {
+                                for( auto & p: this->_entries )
+                                {
+                                    if( p.second.expired == false )
+                                    {
+                                        this->Cancel( p.second, "Global timeout of " + StopWatch::Format( this->_globalTimeout ) + " expired", now );
+                                    }
+                                    
+                                    if( p.second.cancel )
+                                    {
+                                        cancels.push_back( p.second.cancel );
+                                    }
+                                }
+                                
+                                this->Abort( l, cancels, "Global timeout of " + StopWatch::Format( this->_globalTimeout ) + " expired" );
+                                
+                                return;
+                            }
+                        }
+                        
+                        for( auto & p: this->_entries )
+                        {
+                            if( p.second.expired || this->_timeout.count() == 0 )
+                            {
+                                continue;
+                            }
+                            
+                            if( now >= p.second.start + this->_timeout )
+                            {
+                                this->Cancel( p.second, "Timed out after " + StopWatch::Format( this->_timeout ), now );
+                                
+                                if( p.second.cancel )
+                                {
+                                    cancels.push_back( p.second.cancel );
+                                }
+                                else
+                                {
+                                    hung = true;
+                                }
+                            }
+                            else
+                            {
+                                deadline = std::min( deadline, p.second.start + this->_timeout );
+                            }
+                        }
+                        
+                        if( hung )
+                        {
+                            /* A test case running in this process cannot be interrupted, so the whole run is aborted */
+                            this->Abort( l, cancels, "A test case running in process cannot be interrupted" );
+                            
+                            return;
+                        }
+                        
+                        if( cancels.size() > 0 )
+                        {
+                            /* Killing a worker takes a while, so it's done without blocking other test cases from starting or completing */
+                            l.unlock();
+                            
+                            for( const auto & cancel: cancels )
+                            {
+                                cancel();
+                            }
+                            
+                            l.lock();
+                            
+                            continue;
+                        }
+                        
+                        if( deadline == std::chrono::steady_clock::time_point::max() )
+                        {
+                            this->_condition.wait( l );
+                        }
+                        else
+                        {
+                            this->_condition.wait_until( l, deadline );
+                        }
+                    }
+                }
+                
+                /* The Info is still owned by the running test case, so the expiry is only recorded in the entry */
+                void Cancel( Entry & entry, const std::string & reason, std::chrono::steady_clock::time_point now )
+                {
+                    entry.expired  = true;
+                    entry.reason   = reason;
+                    entry.duration = now - entry.start;
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_output );
+                        
+                        Logging::Log( this->_os, reason + ": " + entry.info->GetName() + " (" + entry.info->GetFile() + ":" + std::to_string( entry.info->GetLine() ) + ")", {}, Logging::Style::Failure );
+                        Logging::Flush( this->_os );
+                    }
+                    
+                    /* Cancelable test cases are cancelled by the caller */
+                    if( entry.cancel )
+                    {
+                        return;
+                    }
+                    
+                    #if !defined( _WIN32 ) && defined( XSTEST_HAS_BACKTRACE )
+                    
+                    {
+                        std::chrono::steady_clock::time_point until( std::chrono::steady_clock::now() + std::chrono::seconds( 1 ) );
+                        
+                        StackDumped() = false;
+                        
+                        if( pthread_kill( entry.thread, StackSignal() ) == 0 )
+                        {
+                            while( StackDumped() == false && std::chrono::steady_clock::now() < until )
+                            {
+                                std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+                            }
+                        }
+                    }
+                    
+                    #endif
+                }
+                
+                /*
+                 * Running test cases may still write their Info, so expired ones are reported from snapshots, and running ones are excluded.
+                 * The lock is only released while workers are killed, and test cases started meanwhile are excluded too.
+                 */
+                void Abort( std::unique_lock< std::mutex > & l, const std::vector< std::function< void() > > & cancels, const std::string & reason )
+                {
+                    std::vector< Info >         expired;
+                    std::vector< const Info * > running;
+                    
+                    {
+                        std::lock_guard< std::mutex > lock( this->_output );
+                        
+                        Logging::Log( this->_os, reason + ", aborting...", {}, Logging::Style::Failure );
+                    }
+                    
+                    for( const auto & p: this->_entries )
+                    {
+                        running.push_back( p.second.info );
+                        
+                        if( p.second.expired )
+                        {
+                            expired.push_back( Info( p.second.info->GetRegistration(), p.second.info->GetParameterIndex() ) );
+                            
+                            Expire( expired.back(), p.second.duration, p.second.reason );
+                        }
+                    }
+                    
+                    if( cancels.size() > 0 )
+                    {
+                        l.unlock();
+                        
+                        for( const auto & cancel: cancels )
+                        {
+                            cancel();
+                        }
+                        
+                        l.lock();
+                        
+                        for( const auto & p: this->_entries )
+                        {
+                            if( std::find( running.begin(), running.end(), p.second.info ) == running.end() )
+                            {
+                                running.push_back( p.second.info );
+                            }
+                        }
+                    }
+                    
+                    this->_expired( expired, running );
+                }
+                
+                #ifndef _WIN32
+                
+                static int StackSignal()
+                {
+                    return SIGUSR2;
+                }
+                
+                static std::atomic< bool > & StackDumped()
+                {
+                    static std::atomic< bool > dumped( false );
+                    
+                    return dumped;
+                }
+                
+                static void InstallStackHandler()
+                {
+                    #ifdef XSTEST_HAS_BACKTRACE
+                    
+                    void * frames[ 1 ];
+                    
+                    /* The first call may load libgcc, which is not safe from a signal handler */
+                    backtrace( frames, 1 );
+                    StackDumped();
+                    
+                    signal
+                    (
+                        StackSignal(),
+                        []( int )
+                        {
+                            static const char header[] = "Stack of the timed out test case:\n";
+                            void            * stack[ 64 ];
+                            int               count( backtrace( stack, 64 ) );
+                            
+                            if( write( STDERR_FILENO, header, sizeof( header ) - 1 ) > 0 )
+                            {
+                                backtrace_symbols_fd( stack, count, STDERR_FILENO );
+                            }
+                            
+                            StackDumped() = true;
+                        }
+                    );
+                    
+                    #endif
+                }
+                
+                #else
+                
+                static void InstallStackHandler()
+                {}
+                
+                #endif
+                
+                std::chrono::milliseconds                                                                   _timeout;
+                std::chrono::milliseconds                                                                   _globalTimeout;
+                std::chrono::steady_clock::time_point                                                       _start;
+                Optional< std::reference_wrapper< std::ostream > >                                          _os;
+                std::mutex                                                                                & _output;
+                std::function< void( const std::vector< Info > &, const std::vector< const Info * > & ) >   _expired;
+                std::map< uint64_t, Entry >                                                                 _entries;
+                uint64_t                                                                                    _next;
+                bool                                                                                        _stop;
+                std::mutex                                                                                  _mutex;
+                std::condition_variable                                                                     _condition;
+                std::thread                                                                                 _thread;
+        };
+    }
+}
+
+#endif /* XS_TEST_WATCHDOG_HPP */
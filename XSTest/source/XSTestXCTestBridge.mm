@@ -143,29 +143,15 @@ static id runTestCase( XCTestCase * self, SEL _cmd )
     }
     
     {
-        XS::Test::Info                        & info( *( static_cast< XS::Test::Info * >( assoc ) ) );
-        XS::Test::Optional< XS::Test::Failure > failure;
-        std::string                             file;
-        size_t                                  line;
+        XS::Test::Info & info( *( static_cast< XS::Test::Info * >( assoc ) ) );
         
         if( info.Run( {} ) == false )
         {
-            failure = info.GetFailure();
-            
-            if( failure )
+            for( const auto & failure: info.GetFailures() )
             {
-                file = failure->GetFile();
-                line = failure->GetLine();
-            }
-            else
-            {
-                file = info.GetFile();
-                line = info.GetLine();
-            }
-            
-            {
-                NSString * objcDescription = [ NSString stringWithUTF8String: failure->GetDescription().c_str() ];
-                NSString * objcFile        = [ NSString stringWithUTF8String: file.c_str() ];
+                NSString * objcDescription = [ NSString stringWithUTF8String: failure.GetDescription().c_str() ];
+                NSString * objcFile        = [ NSString stringWithUTF8String: ( ( failure.GetFile().length() > 0 ) ? failure.GetFile() : info.GetFile() ).c_str() ];
+                size_t     line            = ( failure.GetFile().length() > 0 ) ? failure.GetLine() : info.GetLine();
                 
                 if( objcDescription != nil && objcFile != nil )
                 {
@@ -197,7 +183,7 @@ namespace XS
 {
     namespace Test
     {
-        XS_TEST_GET_ALL_INFOS_DECLARATION
-        XS_TEST_GET_ALL_INFOS_DEFINITION
+        XS_TEST_GET_REGISTRY_DECLARATION
+        XS_TEST_GET_REGISTRY_DEFINITION
     }
 }